@@ -89,6 +89,7 @@ namespace Dyninst
         int find(ITYPE* I, std::set<ITYPE*>&) const;
         void successor(interval_type X, std::set<ITYPE*>& ) const;
         ITYPE* successor(interval_type X) const;
+        void elements(std::set<ITYPE*>&) const;
         void clear();
         friend std::ostream& operator<<(std::ostream& stream, const IBSTree_fast<ITYPE>& tree)
         {
@@ -207,6 +208,13 @@ namespace Dyninst
         return *tmp.begin();
     }
     template <typename ITYPE>
+    void IBSTree_fast<ITYPE>::elements(std::set<ITYPE*>& results) const
+    {
+        dyn_rwlock::shared_lock l(rwlock);
+        overlapping_intervals.elements(results);
+        results.insert(unique_intervals.begin(), unique_intervals.end());
+    }
+    template <typename ITYPE>
     void IBSTree_fast<ITYPE>::clear()
     {
         dyn_rwlock::unique_lock l(rwlock);
@@ -243,6 +243,7 @@ private:
 
     int height(IBSNode<ITYPE> *n);
     int CountMarks(IBSNode<ITYPE> *R) const;
+    void collectIntervals(IBSNode<ITYPE> *R, std::set<ITYPE *> &S) const;
 
 public:
     friend std::ostream& operator<<(std::ostream& stream, const IBSTree<ITYPE>& tree)
@@ -308,6 +309,9 @@ public:
     /** Delete all entries in the tree **/
     void clear();
 
+    /** Add every interval in the tree to the set **/
+    void elements(std::set<ITYPE *> &) const;
+
     void PrintPreorder() {
         dyn_rwlock::shared_lock l(rwlock);
         PrintPreorder(root, 0);
@@ -776,6 +780,18 @@ int IBSTree<ITYPE>::CountMarks(IBSNode<ITYPE> *R) const
         CountMarks(R->left) + CountMarks(R->right);
 }
 
+template<class ITYPE>
+void IBSTree<ITYPE>::collectIntervals(IBSNode<ITYPE> *R, std::set<ITYPE *> &S) const
+{
+    // Every interval marks at least the node of its lower endpoint
+    if(R == nil) return;
+    S.insert(R->less.begin(), R->less.end());
+    S.insert(R->equal.begin(), R->equal.end());
+    S.insert(R->greater.begin(), R->greater.end());
+    collectIntervals(R->left, S);
+    collectIntervals(R->right, S);
+}
+
 /***************** Public methods *****************/
 
 template<class ITYPE>
@@ -968,6 +984,13 @@ int IBSTree<ITYPE>::CountMarks() const
     dyn_rwlock::shared_lock l(rwlock);
     return CountMarks(root);
 }
+
+template<class ITYPE>
+void IBSTree<ITYPE>::elements(std::set<ITYPE *> &out) const
+{
+    dyn_rwlock::shared_lock l(rwlock);
+    collectIntervals(root, out);
+}
 }/* Dyninst */
 
 
@@ -284,6 +284,12 @@ public:
             cache[dyn_thread::me] = val;
         }
     }
+
+    // Resets every thread's value to the default
+    void clear() {
+        dyn_rwlock::unique_lock l(lock);
+        cache.clear();
+    }
 };
 
 } // namespace Dyninst
@@ -28,6 +28,30 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#ifndef DYNINST_COMMON_SYMBOLDEMANGLEWITHCACHE_H
+#define DYNINST_COMMON_SYMBOLDEMANGLEWITHCACHE_H
+
+#include "dyninst_visibility.h"
+
 #include <string>
 
-std::string const& symbol_demangle_with_cache(const std::string &symName, bool includeParams);
+// Returns the demangled form of symName.  Results are kept in a bounded
+// cache shared by all threads (size set by DYNINST_DEMANGLE_CACHE_SIZE,
+// 0 disables it) in front of a per-thread copy of the last result.  The
+// returned reference is valid until the calling thread's next call.
+DYNINST_EXPORT std::string const& symbol_demangle_with_cache(const std::string &symName, bool includeParams);
+
+struct symbol_demangle_cache_stats {
+    unsigned long hits;       // lookups that did not need to demangle
+    unsigned long misses;     // lookups that called symbol_demangle
+    unsigned long evictions;  // mangled names dropped to stay under capacity
+    unsigned long entries;    // mangled names currently cached
+    unsigned long capacity;   // maximum number of mangled names cached
+    unsigned long interned;   // distinct demangled strings currently shared
+};
+
+// Hits on another thread's last result are counted once that thread next
+// misses or exits.
+DYNINST_EXPORT symbol_demangle_cache_stats symbol_demangle_cache_get_stats();
+
+#endif
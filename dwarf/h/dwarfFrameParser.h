@@ -59,6 +59,54 @@ typedef enum {
     FE_No_Error
 } FrameErrors_t;
 
+// How to recover one value of the caller's frame, for the rules that
+// can be applied without evaluating a DWARF expression.
+struct UnwindRule {
+    typedef enum {
+        Undefined,  // No rule in the CFI
+        SameValue,  // Unchanged from the callee
+        AtCFA,      // Saved in memory at CFA + offset
+        ValCFA,     // Value is CFA + offset
+        RegOffset,  // Value is reg + offset
+        Expression  // Needs full CFI evaluation
+    } kind_t;
+
+    kind_t kind;
+    MachRegister reg;
+    long offset;
+
+    UnwindRule() : kind(Expression), reg(), offset(0) {}
+    UnwindRule(kind_t k, long off, MachRegister r = MachRegister()) :
+        kind(k), reg(r), offset(off) {}
+};
+
+// The CFA, return address and frame pointer rules for the addresses
+// [start, end).  cfa is either RegOffset or Expression.
+struct UnwindRow {
+    Address start;
+    Address end;
+    UnwindRule cfa;
+    UnwindRule ra;
+    UnwindRule fp;
+};
+
+// A flat, sorted table of UnwindRows compiled from .debug_frame and
+// .eh_frame.  Rows never overlap; lookups are a binary search.
+class DYNINST_EXPORT UnwindTable {
+public:
+    typedef boost::shared_ptr<const UnwindTable> Ptr;
+
+    // Sorts the rows and drops any that overlap an earlier one
+    explicit UnwindTable(std::vector<UnwindRow> rows);
+
+    const UnwindRow *find(Address pc) const;
+    size_t size() const { return rows_.size(); }
+    const std::vector<UnwindRow> &rows() const { return rows_; }
+
+private:
+    std::vector<UnwindRow> rows_;
+};
+
 class DYNINST_EXPORT DwarfFrameParser {
 public:
 
@@ -98,10 +146,15 @@ public:
             std::vector<VariableLocation> &locs,
             FrameErrors_t &err_result);
 
+    // Compiles every FDE into an UnwindTable the first time it is asked
+    // for.  Parsers are shared per file (see create()), so every Walker
+    // unwinding through the same library uses the same table.
+    UnwindTable::Ptr getUnwindTable();
 
 private:
 
     void setupCFIData();
+    void buildUnwindTable();
 
     typedef enum {
         dwarf_status_uninitialized,
@@ -137,6 +190,11 @@ private:
 
     dyn_mutex cfi_lock;
     std::vector<Dwarf_CFI *> cfi_data;
+    Dwarf_CFI *debug_frame_cfi;
+    Dwarf_CFI *eh_frame_cfi;
+
+    boost::once_flag unwind_table_once;
+    UnwindTable::Ptr unwind_table;
 
 };
 
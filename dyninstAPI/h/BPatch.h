@@ -125,6 +125,11 @@ class DYNINST_EXPORT BPatch {
     bool saveFloatingPointsOn;
     bool forceSaveFloatingPointsOn;
 
+    /* If true, the RT library queues user messages and dynamic call
+       site events in per-thread rings instead of stopping the process
+       for each one. Defaults to false */
+    bool eventRingsOn_;
+
     /* If true, we will use liveness calculations to avoid saving
        registers on platforms that support it. 
        Defaults to true. */
@@ -132,6 +137,10 @@ class DYNINST_EXPORT BPatch {
     /* How far through the CFG do we follow calls? */
     int livenessAnalysisDepth_;
 
+    /* How many threads relocate and generate code for the functions
+       of one object in parallel. Defaults to 1 (serial) */
+    unsigned relocationThreads_;
+
     /* If true, override requests to block while waiting for events,
        polling instead */
     bool asyncActive;
@@ -281,6 +290,11 @@ public:
     bool isForceSaveFPROn();        
 
 
+    // BPatch::isEventRingsOn:
+    // returns whether notification events are queued in the mutatee
+    bool isEventRingsOn();
+
+
     // BPatch::hasForcedRelocation_NP:
     // returns whether all instrumented functions will be relocated
     
@@ -307,6 +321,10 @@ public:
     
                int livenessAnalysisDepth();
 
+    // BPatch::relocationThreads:
+    // returns how many threads are used to relocate functions
+    unsigned relocationThreads();
+
 
     //  User-specified callback functions...
 
@@ -487,6 +505,15 @@ public:
     void forceSaveFPR(bool x);
 
 
+    //  BPatch::setEventRings:
+    //  Turn on/off queueing of user messages and dynamic call site events
+    //  in the mutatee. They are then delivered in batches whenever the
+    //  mutatee stops, rather than as they happen. Applies to processes
+    //  created or attached to afterwards.
+
+    void setEventRings(bool x);
+
+
     //  BPatch::setForcedRelocation_NP:
     //  Turn on/off forced relocation of instrumted functions
     
@@ -512,6 +539,13 @@ public:
     
                  void  setLivenessAnalysisDepth(int x);
 
+    //  BPatch::setRelocationThreads:
+    //  Set how many threads build and generate relocated code for the
+    //  functions of one object at once. Allocation, writing, and
+    //  springboards are always done serially. 0 means one per core.
+
+    void setRelocationThreads(unsigned x);
+
     // BPatch::processCreate:
     // Create a new mutatee process
     
@@ -152,6 +152,7 @@ class DYNINST_EXPORT BPatch_addressSpace {
   friend class BPatch_loopTreeNode;
   friend class BPatch_point;
   friend class BPatch_funcCallExpr;
+  friend class BPatch_threadCounterExpr;
   friend class BPatch_eventMailbox;
   friend class BPatch_instruction;
   friend Dyninst::PatchAPI::PatchMgrPtr Dyninst::PatchAPI::convert(const BPatch_addressSpace *);
@@ -281,7 +282,8 @@ class DYNINST_EXPORT BPatch_addressSpace {
 
   //  BPatch_addressSpace::replaceFunction
   //  
-  //  Replace all calls to a function with calls to another
+  //  Replace all calls to a function with calls to another. Functions
+  //  in the runtime library cannot be replaced.
 
   bool replaceFunction(BPatch_function &oldFunc, BPatch_function &newFunc);
 
@@ -293,7 +295,8 @@ class DYNINST_EXPORT BPatch_addressSpace {
   // BPatch_addressSpace::wrapFunction
   //
   // Replace oldFunc with newFunc as above; however, also rename oldFunc
-  // to the provided name so it can still be reached. 
+  // to the provided name so it can still be reached. Functions in the
+  // runtime library cannot be wrapped.
 
   bool wrapFunction(BPatch_function *oldFunc, BPatch_function *newFunc, Dyninst::SymtabAPI::Symbol *clone);
 
@@ -371,6 +374,22 @@ class DYNINST_EXPORT BPatch_addressSpace {
   
   bool free(BPatch_variableExpr &ptr);
 
+  //  BPatch_addressSpace::createThreadCounter
+  //
+  //  Allocate a 64-bit counter of which every mutatee thread has its own
+  //  copy, for BPatch_threadCounterExpr to add to without atomics.
+  //  Returns the counter, or -1 if none are left, the mutatee is not
+  //  64-bit or this is a binary edit.
+
+  int createThreadCounter();
+
+  //  BPatch_addressSpace::readThreadCounter
+  //
+  //  Sum a counter from createThreadCounter over all threads of the
+  //  mutatee process
+
+  bool readThreadCounter(int counter, long long &sum);
+
   // BPatch_addressSpace::createVariable
   // 
   // Wrap an existing piece of allocated memory with a BPatch_variableExpr.
@@ -390,6 +409,14 @@ class DYNINST_EXPORT BPatch_addressSpace {
 
   void allowTraps(bool allowtraps);
 
+  //  BPatch_addressSpace::allowPointPatching
+  //
+  //  On x86-64, instrument a function at its entry, block entry and
+  //  pre-instruction points by patching a jump to a trampoline over the
+  //  instrumented instructions, instead of relocating the function.
+  //  Functions that cannot be handled this way are still relocated.
+  void allowPointPatching(bool allowpatching);
+
   //  BPatch_addressSpace::loadLibrary
   //  
   //  Load a shared library into the mutatee's address space
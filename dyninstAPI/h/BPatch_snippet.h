@@ -520,6 +520,17 @@ class DYNINST_EXPORT BPatch_tidExpr : public BPatch_snippet {
   BPatch_tidExpr(BPatch_process *proc);
 };
 
+class DYNINST_EXPORT BPatch_threadCounterExpr : public BPatch_snippet {
+ public:
+  //
+  // BPatch_threadCounterExpr::BPatch_threadCounterExpr
+  //
+  // Adds value to the calling thread's copy of a counter from
+  // BPatch_addressSpace::createThreadCounter
+  BPatch_threadCounterExpr(BPatch_addressSpace *as, int counter,
+                           const BPatch_snippet &value = BPatch_constExpr(1));
+};
+
 class BPatch_instruction;
 
 typedef enum {
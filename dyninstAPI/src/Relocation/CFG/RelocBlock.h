@@ -31,6 +31,7 @@
 #if !defined(PATCHAPI_TRACE_H_)
 #define PATCHAPI_TRACE_H_
 
+#include <atomic>
 #include <list>
 #include <string>
 #include <utility>
@@ -70,7 +71,8 @@ class RelocBlock {
 
  public:
    typedef int Label;
-   static int RelocBlockID;
+   // Shared by CodeMovers built concurrently
+   static std::atomic<int> RelocBlockID;
    typedef std::list<WidgetPtr> WidgetList;
    typedef enum {
       Relocated,
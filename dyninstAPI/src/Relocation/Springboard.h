@@ -240,6 +240,8 @@ class InstalledSpringboards
 
   void registerBranch(Address start, Address end, const SpringboardReq::Destinations &dest, bool inRelocatedCode, func_instance* func, Priority p);
   void registerBranchInRelocated(Address start, Address end, func_instance* func, Priority p);
+  // Forget springboards written into relocated code that has been freed
+  void removeRelocated(Address start, Address end);
   bool forceTrap(Address a) 
   {
     return relocTraps_.find(a) != relocTraps_.end();
@@ -33,6 +33,7 @@
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <utility>
 #include "Transformer.h"
 #include "dyninstAPI/src/LinearVariable.h"
@@ -158,6 +159,8 @@ class PCSensitiveTransformer : public Transformer {
   typedef std::map<Address, CacheData> CacheEntry;
   typedef std::map<const block_instance *, CacheEntry > AnalysisCache;
   static AnalysisCache analysisCache_;
+  // Transformers for separate CodeMovers may run concurrently
+  static std::mutex analysisCacheLock_;
   
 };
 
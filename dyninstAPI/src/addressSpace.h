@@ -302,6 +302,7 @@ class AddressSpace : public InstructionSource {
 
     // And a shortcut pointer
     std::set<mapped_object *> runtime_lib;
+    bool inRuntimeLib(func_instance *func) const;
     // ... and keep the name around
     std::string dyninstRT_name;
     
@@ -429,6 +430,17 @@ class AddressSpace : public InstructionSource {
     bool canUseTraps();
     void setUseTraps(bool usetraps);
 
+    // Instrument x86-64 functions, where possible, by patching a jump to
+    // a trampoline over the instrumented instructions instead of
+    // relocating the whole function.
+    bool usePointPatching() const { return pointPatching_; }
+    void setPointPatching(bool patch);
+
+    // Per-thread counters kept in the RT library's counter slabs
+    int allocateThreadCounter();
+    long threadCounterTLSOffset();
+    bool readThreadCounter(int counter, long long &sum);
+
     //////////////////////////////////////////////////////
     // The New Hotness
     //////////////////////////////////////////////////////
@@ -499,7 +511,9 @@ class AddressSpace : public InstructionSource {
 
     bool heapInitialized_;
     bool useTraps_;
+    bool pointPatching_;
     bool sigILLTrampoline_;
+    unsigned threadCounters_;
     inferiorHeap heap_;
 
     // Loaded mapped objects (may be just 1)
@@ -519,12 +533,59 @@ class AddressSpace : public InstructionSource {
     bool transform(Dyninst::Relocation::CodeMoverPtr cm);
     Address generateCode(Dyninst::Relocation::CodeMoverPtr cm, Address near);
     bool patchCode(Dyninst::Relocation::CodeMoverPtr cm,
-		   Dyninst::Relocation::SpringboardBuilderPtr spb);
+		   Dyninst::Relocation::SpringboardBuilderPtr spb,
+		   Dyninst::Relocation::CodeTracker *tracker);
 
     typedef std::set<func_instance *> FuncSet;
     std::map<mapped_object *, FuncSet> modifiedFunctions_;
 
     bool relocateInt(FuncSet::const_iterator begin, FuncSet::const_iterator end, Address near);
+    void partitionFuncs(FuncSet::const_iterator begin, FuncSet::const_iterator end,
+                        unsigned n, std::vector<FuncSet> &chunks);
+    void warmRelocationCaches(FuncSet::const_iterator begin, FuncSet::const_iterator end);
+    bool buildCode(Dyninst::Relocation::CodeMoverPtr cm, const FuncSet &funcs);
+    bool installCode(Dyninst::Relocation::CodeMoverPtr cm,
+                     Dyninst::Relocation::SpringboardBuilderPtr spb,
+                     Dyninst::Relocation::CodeTracker *tracker,
+                     const FuncSet &funcs,
+                     Address near);
+
+    // Reclaiming superseded relocated code. Each relocation of a set of
+    // functions produces a new copy, tracked by its CodeTracker. A copy
+    // stays live while it holds the current version of some function or
+    // is the target of some installed springboard; after that it is
+    // superseded, and freed once no thread is running in it.
+    struct RelocatedCopy {
+       Address base;
+       unsigned size;
+       unsigned refs;
+    };
+    std::map<Dyninst::Relocation::CodeTracker *, RelocatedCopy> relocatedCopies_;
+    std::map<func_instance *, Dyninst::Relocation::CodeTracker *> funcCopies_;
+    std::map<Address, Dyninst::Relocation::CodeTracker *> springboardCopies_;
+    std::list<Dyninst::Relocation::CodeTracker *> supersededCopies_;
+
+    bool reclaimsRelocatedCode();
+    void retargetCopy(Dyninst::Relocation::CodeTracker *&current,
+                      Dyninst::Relocation::CodeTracker *copy);
+    void reclaimRelocatedCode();
+
+    // Point patching. Each patched site jumps to its own trampoline,
+    // tracked as a relocated copy through springboardCopies_.
+    struct PatchedSite {
+       func_instance *func;
+       std::vector<unsigned char> orig;
+    };
+    typedef std::map<Address, std::vector<instPoint *> > PatchSites;
+    std::map<Address, PatchedSite> patchedSites_;
+
+    void patchSitesInPlace(FuncSet &funcs);
+    bool canPatchInPlace(func_instance *func, PatchSites &sites,
+                         std::map<Address, unsigned> &lengths);
+    bool patchSite(func_instance *func, Address addr,
+                   const std::vector<instPoint *> &points, unsigned len);
+    bool unpatchSite(Address addr);
+    void unpatchSites(func_instance *func);
     Dyninst::Relocation::InstalledSpringboards::Ptr installedSpringboards_;
  public:
     Dyninst::Relocation::InstalledSpringboards::Ptr getInstalledSpringboards() 
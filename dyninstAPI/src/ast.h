@@ -154,6 +154,7 @@ class AstNode : public Dyninst::PatchAPI::Snippet {
                       origRegister,
                       variableAddr,
                       variableValue,
+                      ThreadLocal, // Word at oValue from the thread pointer
                       undefOperandType };
 
 
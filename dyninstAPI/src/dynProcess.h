@@ -307,6 +307,9 @@ public:
                       Address);
     bool supportsUserThreadEvents(); 
 
+    // Delivers the events queued in the RT library's per-thread rings
+    bool drainEventRings();
+
 protected:
     typedef enum {
         bs_attached,
@@ -350,6 +353,8 @@ protected:
           sync_event_arg2_addr_(0),
           sync_event_arg3_addr_(0),
           sync_event_breakpoint_addr_(0),
+          event_rings_addr_(0),
+          event_rings_used_addr_(0),
           rt_trap_func_addr_(0),
        thread_hash_tids(0),
        thread_hash_indices(0),
@@ -391,6 +396,8 @@ protected:
           sync_event_arg2_addr_(0),
           sync_event_arg3_addr_(0),
           sync_event_breakpoint_addr_(0),
+          event_rings_addr_(0),
+          event_rings_used_addr_(0),
           rt_trap_func_addr_(0),
        thread_hash_tids(0),
        thread_hash_indices(0),
@@ -435,6 +442,8 @@ protected:
           sync_event_arg2_addr_(parent->sync_event_arg2_addr_),
           sync_event_arg3_addr_(parent->sync_event_arg3_addr_),
           sync_event_breakpoint_addr_(parent->sync_event_breakpoint_addr_),
+          event_rings_addr_(parent->event_rings_addr_),
+          event_rings_used_addr_(parent->event_rings_used_addr_),
           rt_trap_func_addr_(parent->rt_trap_func_addr_),
        thread_hash_tids(parent->thread_hash_tids),
        thread_hash_indices(parent->thread_hash_indices),
@@ -487,6 +496,8 @@ protected:
     Address getRTEventArg1Addr();
     Address getRTEventArg2Addr();
     Address getRTEventArg3Addr();
+    Address getRTEventRingsAddr();
+    Address getRTEventRingsUsedAddr();
     Address getRTTrapFuncAddr();
 
     // Shared library managment
@@ -593,6 +604,8 @@ protected:
     Address sync_event_arg2_addr_;
     Address sync_event_arg3_addr_;
     Address sync_event_breakpoint_addr_;
+    Address event_rings_addr_;
+    Address event_rings_used_addr_;
     Address rt_trap_func_addr_;
     Address thread_hash_tids;
     Address thread_hash_indices;
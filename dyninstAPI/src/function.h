@@ -301,6 +301,10 @@ class func_instance : public patchTarget, public Dyninst::PatchAPI::PatchFunctio
   void callPoints(Points*);
   void blockInsnPoints(block_instance*, Points*);
   void edgePoints(Points*);
+  // Instrumented points that run before an instruction (function entry,
+  // block entry, and pre-instruction). False if any other point is
+  // instrumented.
+  bool instrumentedPreInsnPoints(Points*);
 
   // Function wrapping
   bool addSymbolsForCopy();
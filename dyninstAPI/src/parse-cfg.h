@@ -349,6 +349,13 @@ class parse_func : public ParseAPI::Function
    bool writesFPRs(unsigned level = 0);
    bool writesSPRs(unsigned level = 0);
 
+   // Registers, indexed as in liveness analysis, that a call to this
+   // function can overwrite, following its callees. Everything the ABI
+   // lets a call overwrite if the callees cannot all be analyzed.
+   const bitArray &callWrittenRegs();
+   // Whether a call can overwrite floating-point or vector state
+   bool callWritesVectorRegs();
+
 
    void invalidateLiveness() { livenessCalculated_ = false; }
    void calcBlockLevelLiveness();
@@ -364,6 +371,16 @@ class parse_func : public ParseAPI::Function
 
 
  private:
+   // What this function's own instructions write
+   struct regWriteSummary {
+      bool bounded;       // false if its effects could not be determined
+      bool writesVector;
+      bitArray written;
+      std::vector<parse_func *> callees;
+   };
+   const regWriteSummary &localRegWrites();
+   void calcCallWrittenRegs();
+
    void calcUsedRegs();/* Does one time calculation of registers used in a function, if called again
                           it just refers to the stored values and returns that */
 
@@ -379,6 +396,9 @@ class parse_func : public ParseAPI::Function
    parse_func_registers * usedRegisters{nullptr};
    regUseState containsFPRWrites_{unknown};   // floating point registers
    regUseState containsSPRWrites_{unknown};   // stack pointer registers
+   regWriteSummary *localRegWrites_{nullptr};
+   bitArray *callWrittenRegs_{nullptr};
+   bool callWritesVector_{true};
 
    ///////////////////// CFG and function body
    bool containsSharedBlocks_{false};  // True if one or more blocks in this
@@ -335,6 +335,7 @@ class registerSpace {
     // For platforms with "save all" semantics...
     bool anyLiveGPRsAtEntry() const;
     bool anyLiveFPRsAtEntry() const;
+    bool anyFPRsUsed() const;
     bool anyLiveSPRsAtEntry() const;
 
 
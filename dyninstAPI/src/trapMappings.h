@@ -70,6 +70,13 @@ class trampTrapMappings {
    void writeToBuffer(unsigned char *buffer, unsigned long val, 
                       unsigned addr_width);
    void writeTrampVariable(const int_variable *var, unsigned long val);
+   void publishTable(unsigned long used, unsigned long layout);
+
+   // Open-addressed table used when instrumenting a live process; holds
+   // the from_addr stored in each slot of the mutatee's table, 0 if empty
+   std::vector<Dyninst::Address> hash_slots;
+   unsigned findHashSlot(Dyninst::Address from) const;
+   void flushHashTable();
 
    unsigned long table_version;
    unsigned long table_used;
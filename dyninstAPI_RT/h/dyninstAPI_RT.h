@@ -78,7 +78,48 @@ struct DYNINST_bootstrapStruct {
 };
 
 typedef enum {DSE_undefined, DSE_forkEntry, DSE_forkExit, DSE_execEntry, DSE_execExit, DSE_exitEntry, DSE_loadLibrary, DSE_lwpExit, DSE_snippetBreakpoint, DSE_stopThread,
-DSE_userMessage, DSE_dynFuncCall } DYNINST_synch_event_t;
+DSE_userMessage, DSE_dynFuncCall, DSE_eventRingFull } DYNINST_synch_event_t;
+
+/* Per-thread event rings. Events that only notify the mutator (user
+   messages and dynamic call sites) are queued by the reporting thread in
+   its own ring rather than stopping the process for each one. The mutator
+   drains every ring whenever the RT library stops for an event, including
+   the DSE_eventRingFull stop a thread takes when its ring has no room.
+   A thread's ring is handed to a later thread once it exits.
+   The layout is identical for 32- and 64-bit mutatees. */
+#define DYNINST_EVENT_RINGS 64
+#define DYNINST_EVENT_RING_SIZE 128 /* records, a power of two */
+#define DYNINST_EVENT_DATA_SIZE 40
+
+typedef struct {
+   uint32_t type; /* DYNINST_synch_event_t */
+   uint32_t size; /* bytes used in data */
+   uint64_t arg1;
+   uint64_t arg2;
+   unsigned char data[DYNINST_EVENT_DATA_SIZE];
+} DYNINSTeventRecord_t;
+
+typedef struct {
+   volatile uint32_t head; /* advanced only by the owning thread */
+   volatile uint32_t tail; /* advanced only by the mutator */
+   int32_t lwp;
+   uint32_t padding[13];
+   DYNINSTeventRecord_t records[DYNINST_EVENT_RING_SIZE];
+} DYNINSTeventRing_t;
+
+/* Per-thread counters. Each mutatee thread claims a slab holding its own
+   copy of every counter the first time it counts, so instrumentation adds
+   to it without atomics and threads never share a cache line. Slabs are
+   handed back, counts intact, when their thread exits. Threads that find
+   every slab taken add to DYNINST_counter_overflow atomically. The mutator
+   sums a counter over DYNINST_counter_overflow and the first
+   DYNINST_counter_slabs_used slabs. Only 64-bit mutatees use these. */
+#define DYNINST_COUNTER_SLABS 256
+#define DYNINST_COUNTER_SLOTS 128
+
+typedef struct {
+   int64_t counts[DYNINST_COUNTER_SLOTS];
+} DYNINSTcounterSlab_t;
 
 extern int DYNINSTdebugPrintRT; /* control run-time lib debug/trace prints */
 #if !defined(RTprintf)
@@ -167,6 +208,23 @@ typedef struct {
 #define TRAP_HEADER_SIG 0x759191D6
 #define DT_DYNINST 0x6D191957
 
+/* Layouts of the trap table published in dyninstTrapTableIsSorted */
+#define TRAP_TABLE_UNSORTED 0
+#define TRAP_TABLE_SORTED 1
+/* Open addressing with linear probing. dyninstTrapTableUsed holds the
+   number of slots, a power of two, and empty slots have a NULL source. */
+#define TRAP_TABLE_HASHED 2
+
+/* Home slot of a trap address in a TRAP_TABLE_HASHED table. The mutator
+   builds the table with this, so it must not change independently. */
+static inline unsigned long DYNINSTtrapHash(uint64_t addr, unsigned long mask)
+{
+   addr ^= addr >> 33;
+   addr *= 0xff51afd7ed558ccdULL;
+   addr ^= addr >> 33;
+   return (unsigned long) (addr & mask);
+}
+
 // Suppress warning about flexible array members not valid in C++
 // FIXME: invalid flexible array member, traps[], in structure below
 DYNINST_DIAGNOSTIC_BEGIN_SUPPRESS_FLEX_ARRAY
@@ -147,6 +147,121 @@ DLLEXPORT void DYNINST_unlock_tramp_guard(void)
 
 DECLARE_DYNINST_LOCK(DYNINST_trace_lock);
 
+/**
+ * Pools of per-thread resources.  A thread claims the lowest index never
+ * handed out, or one handed back by a thread that has exited, and keeps
+ * it until it exits itself.  The mutator reads every index below the
+ * pool's high-water mark, *used.
+ **/
+typedef struct {
+   dyninst_lock_t lock;
+   volatile unsigned *used;
+   unsigned size;
+   unsigned *free;
+   volatile unsigned free_count;
+} DYNINSTthreadPool_t;
+
+#define DECLARE_THREAD_POOL(pool, used, size, free) \
+   DYNINSTthreadPool_t pool = {{0, DYNINST_INITIAL_LOCK_PID}, &(used), (size), (free), 0}
+
+/* A cheap check, without the lock, that a claim might succeed */
+static int DYNINSTpoolMayClaim(DYNINSTthreadPool_t *pool)
+{
+   return pool->free_count || *pool->used < pool->size;
+}
+
+/* Returns the claimed index, or -1 if every one is taken */
+static int DYNINSTpoolClaim(DYNINSTthreadPool_t *pool)
+{
+   int idx = -1;
+
+   tc_lock_lock(&pool->lock);
+   if (pool->free_count)
+      idx = (int) pool->free[--pool->free_count];
+   else if (*pool->used < pool->size)
+      idx = (int) (*pool->used)++;
+   tc_lock_unlock(&pool->lock);
+
+   /* Without a way to learn of the thread's exit the index is never reused */
+   if (idx >= 0)
+      dyn_thread_exit_notify();
+   return idx;
+}
+
+static void DYNINSTpoolRelease(DYNINSTthreadPool_t *pool, unsigned idx)
+{
+   tc_lock_lock(&pool->lock);
+   pool->free[pool->free_count++] = idx;
+   tc_lock_unlock(&pool->lock);
+}
+
+/**
+ * Per-thread counters, see dyninstAPI_RT.h.  A thread claims a slab the
+ * first time it counts and hands it back when it exits, keeping its
+ * counts.  A thread that finds none left adds to DYNINST_counter_overflow
+ * atomically instead; no slab is ever shared.  Where the mutator supports
+ * it, instrumentation reads the thread's slab directly,
+ * DYNINST_counter_tls_offset bytes from the thread pointer, and only
+ * calls DYNINST_thread_counter_add while it is unset; elsewhere it calls
+ * DYNINST_thread_counter_add for every count.
+ **/
+DLLEXPORT DYNINSTcounterSlab_t DYNINST_counter_slabs[DYNINST_COUNTER_SLABS];
+DLLEXPORT volatile unsigned DYNINST_counter_slabs_used = 0;
+DLLEXPORT DYNINSTcounterSlab_t DYNINST_counter_overflow;
+DLLEXPORT long DYNINST_counter_tls_offset = 0;
+
+static TLS_VAR int64_t *DYNINST_tls_counter_slab = NULL;
+
+static unsigned DYNINST_counter_free[DYNINST_COUNTER_SLABS];
+static DECLARE_THREAD_POOL(DYNINST_counter_pool, DYNINST_counter_slabs_used,
+                           DYNINST_COUNTER_SLABS, DYNINST_counter_free);
+
+static void DYNINSTreleaseCounterSlab(void)
+{
+   DYNINSTcounterSlab_t *slab = (DYNINSTcounterSlab_t *) DYNINST_tls_counter_slab;
+
+   if (!slab)
+      return;
+   DYNINST_tls_counter_slab = NULL;
+   DYNINSTpoolRelease(&DYNINST_counter_pool, (unsigned) (slab - DYNINST_counter_slabs));
+}
+
+DLLEXPORT void DYNINST_thread_counter_add(long counter, long value)
+{
+   int64_t *slab = DYNINST_tls_counter_slab;
+
+   if (counter < 0 || counter >= DYNINST_COUNTER_SLOTS)
+      return;
+   if (!slab && DYNINSTpoolMayClaim(&DYNINST_counter_pool)) {
+      int idx = DYNINSTpoolClaim(&DYNINST_counter_pool);
+      if (idx >= 0)
+         slab = DYNINST_tls_counter_slab = DYNINST_counter_slabs[idx].counts;
+   }
+   if (slab) {
+      slab[counter] += value;
+      return;
+   }
+
+#if defined(__GNUC__)
+   __sync_fetch_and_add(&DYNINST_counter_overflow.counts[counter], (int64_t) value);
+#else
+   tc_lock_lock(&DYNINST_counter_pool.lock);
+   DYNINST_counter_overflow.counts[counter] += value;
+   tc_lock_unlock(&DYNINST_counter_pool.lock);
+#endif
+}
+
+static void initCounterTLSOffset(void)
+{
+#if defined(__x86_64__) && defined(__GNUC__)
+   /* Initial-exec TLS is at the same offset from every thread's pointer,
+      which the x86-64 ABIs keep at %fs:0 */
+   char *tp;
+   __asm__ __volatile__("mov %%fs:0, %0" : "=r" (tp));
+   DYNINST_counter_tls_offset = (long) ((char *) &DYNINST_tls_counter_slab - tp);
+#endif
+}
+
 /**
  * Init the FPU.  We've seen bugs with Linux (e.g., Redhat 6.2 stock kernel on
  * PIIIs) where processes started by Paradyn started with FPU uninitialized.
@@ -170,6 +285,7 @@ void DYNINSTBaseInit(void)
    DYNINSTinitializeTrapHandler();
 #endif
    DYNINST_unlock_tramp_guard();
+   initCounterTLSOffset();
    DYNINSThasInitialized = 1;
 }
 
@@ -534,12 +650,126 @@ DLLEXPORT RT_Boolean DYNINST_boundsCheck(void **boundsArray_, void *arrayLen_,
 }
 
 
+/**
+ * Per-thread event rings, see dyninstAPI_RT.h.  The mutator turns them on
+ * through DYNINST_event_rings_enabled.  A thread claims a ring the first
+ * time it reports an event and is its only producer, so queueing an event
+ * takes no lock.  It hands the ring back when it exits; records it left
+ * in it are still drained, as the mutator does not tell rings apart.
+ * Threads that find every ring taken, events with too much data and
+ * compilers without the needed builtins fall back to stopping the
+ * process under DYNINST_trace_lock as before.
+ **/
+DLLEXPORT int DYNINST_event_rings_enabled = 0;
+DLLEXPORT volatile unsigned DYNINST_event_rings_used = 0;
+DLLEXPORT DYNINSTeventRing_t DYNINST_event_rings[DYNINST_EVENT_RINGS];
+
+/* 0 until the thread claims a ring, then its index + 1 */
+static TLS_VAR int DYNINST_tls_event_ring = 0;
+
+static unsigned DYNINST_event_rings_free[DYNINST_EVENT_RINGS];
+static DECLARE_THREAD_POOL(DYNINST_event_ring_pool, DYNINST_event_rings_used,
+                           DYNINST_EVENT_RINGS, DYNINST_event_rings_free);
+
+static DYNINSTeventRing_t *DYNINSTthreadEventRing(void)
+{
+#if defined(__GNUC__)
+   if (!DYNINST_tls_event_ring) {
+      int idx;
+      if (!DYNINSTpoolMayClaim(&DYNINST_event_ring_pool))
+         return NULL;
+      idx = DYNINSTpoolClaim(&DYNINST_event_ring_pool);
+      if (idx < 0)
+         return NULL;
+      DYNINST_event_rings[idx].lwp = dyn_lwp_self();
+      DYNINST_tls_event_ring = idx + 1;
+   }
+   return &DYNINST_event_rings[DYNINST_tls_event_ring - 1];
+#else
+   return NULL;
+#endif
+}
+
+static void DYNINSTreleaseEventRing(void)
+{
+   int idx = DYNINST_tls_event_ring - 1;
+
+   if (idx < 0)
+      return;
+   DYNINST_tls_event_ring = 0;
+   DYNINSTpoolRelease(&DYNINST_event_ring_pool, (unsigned) idx);
+}
+
+/* Run through dyn_thread_exit_notify as a thread that claimed a pool
+   index exits */
+void DYNINSTthreadExit(void)
+{
+   DYNINSTreleaseCounterSlab();
+   DYNINSTreleaseEventRing();
+}
+
+/* Stops the process so that the mutator drains every ring */
+static void DYNINSTflushEventRings(void)
+{
+   tc_lock_lock(&DYNINST_trace_lock);
+
+   DYNINST_synch_event_id = DSE_eventRingFull;
+   DYNINST_synch_event_arg1 = NULL;
+   DYNINSTbreakPoint();
+   DYNINST_synch_event_id = DSE_undefined;
+
+   tc_lock_unlock(&DYNINST_trace_lock);
+}
+
+/**
+ * Queues an event in the calling thread's ring.  Returns 0 if the event
+ * has to be reported synchronously instead.
+ **/
+static int DYNINSTqueueEvent(DYNINST_synch_event_t type, void *arg1, void *arg2,
+                             const void *data, unsigned size)
+{
+   DYNINSTeventRing_t *ring;
+   DYNINSTeventRecord_t *rec;
+   uint32_t head;
+
+   if (!DYNINST_event_rings_enabled || size > DYNINST_EVENT_DATA_SIZE)
+      return 0;
+   ring = DYNINSTthreadEventRing();
+   if (!ring)
+      return 0;
+
+   head = ring->head;
+   if (head - ring->tail >= DYNINST_EVENT_RING_SIZE) {
+      DYNINSTflushEventRings();
+      if (head - ring->tail >= DYNINST_EVENT_RING_SIZE)
+         return 0;
+   }
+
+   rec = &ring->records[head & (DYNINST_EVENT_RING_SIZE - 1)];
+   rec->type = (uint32_t) type;
+   rec->size = size;
+   rec->arg1 = (uint64_t) (uintptr_t) arg1;
+   rec->arg2 = (uint64_t) (uintptr_t) arg2;
+   if (size)
+      memcpy(rec->data, data, size);
+
+   /* The record must be complete before the mutator can see it */
+#if defined(__GNUC__)
+   __sync_synchronize();
+#endif
+   ring->head = head + 1;
+   return 1;
+}
+
 /**
  * Used to report addresses of functions called at dynamic call sites
  **/
 DLLEXPORT int DYNINSTasyncDynFuncCall (void * call_target, void *call_addr) {
     if (DYNINSTstaticMode) return 0;
 
+    if (DYNINSTqueueEvent(DSE_dynFuncCall, call_target, call_addr, NULL, 0))
+        return 0;
+
     tc_lock_lock(&DYNINST_trace_lock);
 
     /* Set the state so the mutator knows what's up */
@@ -565,6 +795,9 @@ int DYNINSTuserMessage(void *msg, unsigned int msg_size) {
 		return 0;
 	}
 
+    if (DYNINSTqueueEvent(DSE_userMessage, NULL, NULL, msg, msg_size))
+        return 0;
+
     tc_lock_lock(&DYNINST_trace_lock);
 
 
@@ -668,17 +901,32 @@ void* dyninstTrapTranslate(void *source,
                            volatile unsigned long *table_used,
                            volatile unsigned long *table_version,
                            volatile trapMapping_t **trap_table,
-                           volatile unsigned long *is_sorted)
+                           volatile unsigned long *table_layout)
 {
    volatile unsigned local_version;
-   unsigned i;
+   unsigned long i;
    void *target;
 
    do {
       local_version = *table_version;
       target = NULL;
 
-      if (*is_sorted)
+      if (*table_layout == TRAP_TABLE_HASHED)
+      {
+         unsigned long mask = *table_used - 1;
+         unsigned long slot = DYNINSTtrapHash((uint64_t) (uintptr_t) source, mask);
+
+         for (i = 0; i <= mask; i++) {
+            volatile trapMapping_t *entry = &(*trap_table)[(slot + i) & mask];
+            if (entry->source == source) {
+               target = entry->target;
+               break;
+            }
+            if (!entry->source)
+               break;
+         }
+      }
+      else if (*table_layout == TRAP_TABLE_SORTED)
       {
          unsigned min = 0;
          unsigned mid = 0;
@@ -705,7 +953,7 @@ void* dyninstTrapTranslate(void *source,
             }
          }
       }
-      else { /*!dyninstTrapTableIsSorted*/
+      else { /*TRAP_TABLE_UNSORTED*/
          for (i = 0; i<*table_used; i++) {
             if ((*trap_table)[i].source == source) {
                target = (*trap_table)[i].target;
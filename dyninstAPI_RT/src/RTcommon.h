@@ -51,7 +51,7 @@ void* dyninstTrapTranslate(void *source,
                            volatile unsigned long *table_used,
                            volatile unsigned long *table_version,
                            volatile trapMapping_t **trap_table,
-                           volatile unsigned long *is_sorted);
+                           volatile unsigned long *table_layout);
 
 extern int DYNINST_mutatorPid;
 extern int libdyninstAPI_RT_init_localCause;
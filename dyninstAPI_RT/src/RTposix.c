@@ -49,6 +49,7 @@
 #include <memory.h>
 #include <sys/socket.h>
 #include <pwd.h>
+#include <pthread.h>
 
 #include "dyninstAPI_RT/h/dyninstAPI_RT.h"
 #include "dyninstAPI_RT/src/RTcommon.h"
@@ -290,3 +291,39 @@ int DYNINSTinitializeTrapHandler(void)
 }
 
 #endif
+
+/*
+ * Thread exits are learned of through a pthread key destructor.  The
+ * pthread functions are weak so that the static RT library does not
+ * depend on libpthread; without them threads are never reported as
+ * exiting.
+ */
+#pragma weak pthread_once
+#pragma weak pthread_key_create
+#pragma weak pthread_setspecific
+
+static pthread_once_t DYNINST_exit_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t DYNINST_exit_key;
+static int DYNINST_exit_key_valid = 0;
+
+static void DYNINSTexitKeyDestructor(void *arg)
+{
+   (void) arg;
+   DYNINSTthreadExit();
+}
+
+static void DYNINSTcreateExitKey(void)
+{
+   if (pthread_key_create(&DYNINST_exit_key, DYNINSTexitKeyDestructor) == 0)
+      DYNINST_exit_key_valid = 1;
+}
+
+int dyn_thread_exit_notify(void)
+{
+   if (!pthread_once || !pthread_key_create || !pthread_setspecific)
+      return 0;
+   pthread_once(&DYNINST_exit_key_once, DYNINSTcreateExitKey);
+   if (!DYNINST_exit_key_valid)
+      return 0;
+   return pthread_setspecific(DYNINST_exit_key, (void *) 1) == 0;
+}
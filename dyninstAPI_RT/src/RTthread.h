@@ -37,6 +37,8 @@
 DLLEXPORT dyntid_t dyn_pthread_self(void);    /*Thread library identifier*/
 int dyn_lwp_self(void);    /*LWP used by the kernel identifier*/
 int dyn_pid_self(void);    /*PID identifier representing the containing process*/
+int dyn_thread_exit_notify(void); /*Run DYNINSTthreadExit when this thread exits*/
+void DYNINSTthreadExit(void);
 
 extern int DYNINST_multithread_capable;
 
@@ -282,6 +282,12 @@ dyntid_t dyn_pthread_self()
    return (dyntid_t) dyn_lwp_self();
 }
 
+int dyn_thread_exit_notify(void)
+{
+   /* Thread exits are not reported, so per-thread resources are not reused */
+   return 0;
+}
+
 int DYNINSTthreadInfo(BPatch_newThreadEventRecord *ev)
 {
     return 1;
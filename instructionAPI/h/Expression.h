@@ -78,6 +78,7 @@ namespace Dyninst { namespace InstructionAPI {
     virtual std::string format(Dyninst::Architecture, formatStyle = defaultStyle) const = 0;
     virtual std::string format(formatStyle = defaultStyle) const = 0;
 
+    // Not for Immediates, which may be shared between instructions
     void setValue(const Result& knownValue);
     void clearValue();
 
@@ -38,6 +38,10 @@
 #include <string>
 
 namespace Dyninst { namespace InstructionAPI {
+  // Nodes from makeImmediate may be shared by every instruction the thread
+  // decodes, so they must be treated as immutable: setValue or clearValue
+  // on one would change the constant everywhere it is used. bind never
+  // changes an Immediate.
   class DYNINST_EXPORT Immediate : public Expression {
   public:
     Immediate(const Result& val);
@@ -48,6 +52,7 @@ namespace Dyninst { namespace InstructionAPI {
 
     virtual void getUses(std::set<Expression::Ptr>&) override;
     virtual bool isUsed(Expression::Ptr findMe) const override;
+    virtual bool bind(Expression* expr, const Result& value) override;
 
     virtual std::string format(Architecture, formatStyle) const override;
     virtual std::string format(formatStyle) const override;
@@ -0,0 +1,137 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#if !defined(INSTRUCTION_BATCH_H)
+#define INSTRUCTION_BATCH_H
+
+#include "Architecture.h"
+#include "Instruction.h"
+#include "InstructionCategories.h"
+#include "dyninst_visibility.h"
+#include "entryIDs.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace Dyninst { namespace InstructionAPI {
+
+  /*
+   *  A fixed-size summary of one decoded instruction.
+   *
+   *  These are produced by InstructionDecoder::decodeBatch without building
+   *  an Operation or any operand Expressions. The operand counts come from
+   *  the decoder tables: they describe the explicit operands as encoded and
+   *  may differ from getAllOperands() where the full decoder synthesizes
+   *  extra operands (e.g., flags, the stack pointer, or aarch64 immediates
+   *  folded into an addressing mode). Use InstructionBatch::instruction to
+   *  get the full Instruction for a record.
+   */
+  struct CompactInstruction {
+    enum flag : uint16_t {
+      control_flow = 1U << 0, // branch, call, or return
+      call = 1U << 1,
+      ret = 1U << 2,
+      conditional = 1U << 3,
+      indirect = 1U << 4,
+      reads_memory = 1U << 5,
+      writes_memory = 1U << 6,
+      vector = 1U << 7,
+    };
+
+    uint32_t offset;        // from InstructionBatch::base()
+    entryID id;
+    uint8_t length;
+    uint8_t category;       // InsnCategory
+    uint16_t flags;
+    uint8_t num_registers;
+    uint8_t num_immediates;
+    uint8_t num_memory;
+
+    InsnCategory getCategory() const { return static_cast<InsnCategory>(category); }
+    bool has(flag f) const { return (flags & f) != 0; }
+    bool isControlFlow() const { return has(control_flow); }
+    bool isCall() const { return has(call); }
+    bool isReturn() const { return has(ret); }
+    bool isConditional() const { return has(conditional); }
+    bool isIndirect() const { return has(indirect); }
+    bool readsMemory() const { return has(reads_memory); }
+    bool writesMemory() const { return has(writes_memory); }
+  };
+
+  /*
+   *  A contiguous arena of CompactInstructions decoded from one byte range.
+   *
+   *  The batch does not own the bytes it was decoded from; they must outlive
+   *  any Instruction materialized from it. Reusing a batch across calls to
+   *  decodeBatch keeps its storage.
+   */
+  class DYNINST_EXPORT InstructionBatch {
+    friend class InstructionDecoder;
+
+  public:
+    using const_iterator = std::vector<CompactInstruction>::const_iterator;
+
+    InstructionBatch() = default;
+
+    size_t size() const { return m_insns.size(); }
+    bool empty() const { return m_insns.empty(); }
+    const_iterator begin() const { return m_insns.begin(); }
+    const_iterator end() const { return m_insns.end(); }
+    CompactInstruction const& operator[](size_t i) const { return m_insns[i]; }
+
+    const unsigned char* base() const { return m_base; }
+    Architecture getArch() const { return m_arch; }
+
+    // Number of bytes covered by the batch
+    size_t bytes() const {
+      return m_insns.empty() ? 0 : m_insns.back().offset + m_insns.back().length;
+    }
+
+    const unsigned char* ptr(CompactInstruction const& ci) const { return m_base + ci.offset; }
+
+    // Decodes the full Instruction for the i-th record. As with
+    // InstructionDecoder::decode, operands are only built when first queried.
+    Instruction instruction(size_t i) const;
+
+    void clear() {
+      m_insns.clear();
+      m_base = nullptr;
+    }
+
+  private:
+    const unsigned char* m_base{};
+    Architecture m_arch{Arch_none};
+    std::vector<CompactInstruction> m_insns;
+  };
+
+}}
+
+#endif
@@ -32,7 +32,9 @@
 #define INSTRUCTION_DECODER_H
 
 #include "Instruction.h"
+#include "InstructionBatch.h"
 
+#include <limits>
 #include <stddef.h>
 
 namespace Dyninst { namespace InstructionAPI {
@@ -54,6 +56,14 @@ namespace Dyninst { namespace InstructionAPI {
     Instruction decode();
     Instruction decode(const unsigned char* buffer);
 
+    // Decodes from the current position into `batch`, replacing its contents,
+    // until the end of the buffer, `max_insns` records, or the first byte
+    // sequence that is not a legal instruction. The decoder is left at that
+    // instruction so that decode() can report it. Returns the number of
+    // records produced.
+    size_t decodeBatch(InstructionBatch& batch,
+                       size_t max_insns = std::numeric_limits<size_t>::max());
+
     struct DYNINST_EXPORT buffer {
       const unsigned char* start;
       const unsigned char* end;
@@ -0,0 +1,99 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef DYNINST_INSTRUCTIONAPI_EXPRESSIONARENA_H
+#define DYNINST_INSTRUCTIONAPI_EXPRESSIONARENA_H
+
+#include "Expression.h"
+#include "Result.h"
+
+#include <boost/make_shared.hpp>
+#include <cstddef>
+#include <utility>
+
+/*
+ *  Allocation for the operand ASTs built by the decoders.
+ *
+ *  Nodes and their shared_ptr control blocks come from per-thread pools of
+ *  fixed-size blocks instead of individual heap allocations. A block freed
+ *  on any thread is reused by that thread; pools of exited threads are
+ *  handed to the next thread that needs memory. Pool memory is kept for
+ *  the life of the process.
+ *
+ *  Small integer Immediates are interned per thread. RegisterASTs are not:
+ *  Expression::bind stores a value in the register node itself, so they
+ *  can't be shared between instructions. Immediate::bind is a no-op, and
+ *  interning relies on nothing calling setValue or clearValue on an
+ *  Immediate; today only BinaryFunction sets values, and only on itself.
+ *
+ *  Set DYNINST_EXPR_ARENA=0 to use the global heap instead.
+ */
+
+namespace Dyninst { namespace InstructionAPI { namespace arena {
+
+  bool enabled();
+
+  void* allocate(std::size_t bytes);
+  void deallocate(void* p, std::size_t bytes) noexcept;
+
+  template <typename T>
+  struct allocator {
+    using value_type = T;
+
+    allocator() = default;
+    template <typename U>
+    allocator(allocator<U> const&) noexcept {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(arena::allocate(n * sizeof(T))); }
+    void deallocate(T* p, std::size_t n) noexcept { arena::deallocate(p, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(allocator<U> const&) const noexcept {
+      return true;
+    }
+    template <typename U>
+    bool operator!=(allocator<U> const&) const noexcept {
+      return false;
+    }
+  };
+
+  template <typename T, typename... Args>
+  boost::shared_ptr<T> make(Args&&... args) {
+    if(!enabled())
+      return boost::make_shared<T>(std::forward<Args>(args)...);
+    return boost::allocate_shared<T>(allocator<T>{}, std::forward<Args>(args)...);
+  }
+
+  // The shared node for `val`, or nullptr if it isn't interned
+  Expression::Ptr interned_immediate(const Result& val);
+
+}}}
+
+#endif
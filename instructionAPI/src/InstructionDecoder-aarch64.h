@@ -57,6 +57,7 @@ namespace Dyninst { namespace InstructionAPI {
 
     virtual bool decodeOperands(const Instruction* insn_to_complete);
     virtual void doDelayedDecode(const Instruction* insn_to_complete);
+    virtual bool decodeCompact(InstructionDecoder::buffer& b, CompactInstruction& out);
 
     static const std::array<std::string, 16> condNames;
     static MachRegister sysRegMap(unsigned int);
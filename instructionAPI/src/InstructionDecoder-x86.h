@@ -57,6 +57,7 @@ namespace Dyninst { namespace InstructionAPI {
 
     DYNINST_EXPORT virtual void setMode(bool is64);
     virtual void doDelayedDecode(const Instruction* insn_to_complete);
+    virtual bool decodeCompact(InstructionDecoder::buffer& b, CompactInstruction& out);
 
   protected:
     virtual bool decodeOperands(const Instruction* insn_to_complete);
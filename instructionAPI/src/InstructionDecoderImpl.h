@@ -54,6 +54,14 @@ class InstructionDecoderImpl
         virtual Instruction decode(InstructionDecoder::buffer& b) = 0;
         virtual void doDelayedDecode(const Instruction* insn_to_complete) = 0;
         virtual void setMode(bool is64) = 0;
+
+        // Summarizes the instruction at b.start into `out` (all but its offset)
+        // and advances b past it. Returns false, leaving b unchanged, if the
+        // bytes are not a legal instruction. The default decodes a full
+        // Instruction; decoders override it to skip building operands.
+        virtual bool decodeCompact(InstructionDecoder::buffer& b, CompactInstruction& out);
+
+        Architecture getArch() const { return m_Arch; }
         static Ptr makeDecoderImpl(Architecture a);
 
     protected:
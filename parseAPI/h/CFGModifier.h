@@ -79,6 +79,18 @@ class CFGModifier {
    // As the above, but for functions. 
    DYNINST_EXPORT static bool remove(Function *);
 
+   // Replace a CodeRegion of a parsed CodeObject, e.g. after a shared
+   // library is reloaded. Functions whose blocks in the old region are
+   // byte-for-byte the same in the new one keep their Function and Block
+   // objects; the rest are removed and re-parsed from `entries' (or from
+   // their old entry points if none are given). Edges into replaced code
+   // from elsewhere are relinked by address. The new region becomes owned
+   // by the CodeSource and the old one is destroyed.
+   DYNINST_EXPORT static bool replace(CodeObject *obj, CodeRegion *oldRegion,
+                                      CodeRegion *newRegion,
+                                      const std::vector<Address> &entries =
+                                         std::vector<Address>());
+
    // Label a block as the entry of a new function. If the block is already an
    // entry that function is returned; otherwise we create a new function and
    // return it.
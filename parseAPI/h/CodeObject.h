@@ -155,6 +155,43 @@ class CodeObject {
      */
     DYNINST_EXPORT void finalize();
 
+    /*
+     * Finalizes, then copies the function and block lookup tables
+     * into flat arrays that lookups read without taking locks. The
+     * copies are dropped when parsing resumes or the CFG is modified,
+     * and lookups use the live tables until the next call. Worth it
+     * only once the CFG will not change for a while.
+     */
+    DYNINST_EXPORT void freezeLookups();
+
+    /*
+     * Persistent CFG cache. saveCFGCache writes the finalized CFG to
+     * `path'; loadCFGCache rebuilds the CFG from such a file in place
+     * of parsing, and only succeeds before any parsing has been done
+     * (e.g., on a CodeObject constructed with ignoreParse).
+     *
+     * If DYNINST_CFG_CACHE_DIR is set in the environment, parse() does
+     * both transparently for CodeSources that provide a cacheKey().
+     */
+    DYNINST_EXPORT bool saveCFGCache(std::string const& path);
+    DYNINST_EXPORT bool loadCFGCache(std::string const& path);
+
+    /*
+     * Number of threads used while parsing; zero selects the OpenMP
+     * default. The initial value comes from DYNINST_PARSE_THREADS, so
+     * construct with ignoreParse to change it before the first parse.
+     */
+    DYNINST_EXPORT void setParseThreads(unsigned n);
+    DYNINST_EXPORT unsigned parseThreads() const;
+
+    /*
+     * Replaces one CodeRegion, re-parsing only the code that changed.
+     * See CFGModifier::replace.
+     */
+    DYNINST_EXPORT bool replaceRegion(CodeRegion *oldRegion, CodeRegion *newRegion,
+                                      const std::vector<Address> &entries =
+                                         std::vector<Address>());
+
     /*
      * Deletion support
      */
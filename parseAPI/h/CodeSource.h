@@ -207,13 +207,21 @@ class DYNINST_EXPORT CodeSource : public Dyninst::InstructionSource {
     virtual void stopTimer(const std::string& /*name*/) const { return; }
     virtual bool findCatchBlockByTryRange(Address /*given try address*/, std::set<Address> & /* catch start */)  const { return false; }
 
+    /* A string that uniquely identifies the code provided by this
+       source (e.g., an ELF build-id), used to key persistent CFG
+       caches. An empty key disables caching.
+
+       Optional.
+    */
+    virtual std::string cacheKey() const { return std::string(); }
+
     virtual ~CodeSource();
  protected:
     CodeSource() : _regions_overlap(false),
                    _table_of_contents(0) {}
 
     void addRegion(CodeRegion *);
-    void removeRegion(CodeRegion *);
+    virtual void removeRegion(CodeRegion *);
    
  private: 
     // statistics
@@ -328,6 +336,8 @@ class DYNINST_EXPORT SymtabCodeSource : public CodeSource, public boost::lockabl
     void startTimer(const std::string& /*name*/) const; 
     void stopTimer(const std::string& /*name*/) const;
     bool findCatchBlockByTryRange(Address /*given try address*/, std::set<Address> & /* catch start */)  const;
+
+    std::string cacheKey() const;
  private:
     void init(hint_filt *, bool);
     void init_regions(hint_filt *, bool);
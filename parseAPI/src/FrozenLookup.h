@@ -0,0 +1,168 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _FROZEN_LOOKUP_H_
+#define _FROZEN_LOOKUP_H_
+
+#include <algorithm>
+#include <set>
+#include <stddef.h>
+#include <vector>
+
+#include "dyntypes.h"
+
+namespace Dyninst {
+namespace ParseAPI {
+
+/*
+ * A sorted set of addresses stored in Eytzinger (breadth-first) order.
+ * Searching walks down an implicit binary tree with no branches on the
+ * comparison, and the first levels share a handful of cache lines. Results
+ * are positions in ascending order, so they index arrays kept in sorted
+ * order alongside.
+ */
+class eytzinger_index {
+ public:
+    static const size_t npos = static_cast<size_t>(-1);
+
+    void build(std::vector<Address> const& sorted) {
+        n_ = sorted.size();
+        keys_.assign(n_ + 1, 0);
+        rank_.assign(n_ + 1, 0);
+        size_t next = 0;
+        fill(sorted, next, 1);
+    }
+
+    size_t size() const { return n_; }
+
+    // Position of the first key >= x (lower_bound) or > x (upper_bound);
+    // size() if there is none
+    size_t lower_bound(Address x) const { return rank(search<false>(x)); }
+    size_t upper_bound(Address x) const { return rank(search<true>(x)); }
+
+    // Position of x, or npos
+    size_t find(Address x) const {
+        size_t k = search<false>(x);
+        return (k && keys_[k] == x) ? rank_[k] : npos;
+    }
+
+ private:
+    size_t n_{};
+    std::vector<Address> keys_;  // 1-based tree; keys_[0] is unused
+    std::vector<size_t> rank_;   // tree slot -> sorted position
+
+    void fill(std::vector<Address> const& sorted, size_t &next, size_t k) {
+        if(k > n_) return;
+        fill(sorted, next, 2 * k);
+        keys_[k] = sorted[next];
+        rank_[k] = next++;
+        fill(sorted, next, 2 * k + 1);
+    }
+
+    // Slot of the first key >= x (or > x), 0 if there is none
+    template <bool strict>
+    size_t search(Address x) const {
+        size_t k = 1;
+        while(k <= n_)
+            k = 2 * k + (strict ? keys_[k] <= x : keys_[k] < x);
+        // Undo the trailing right turns and the last left turn
+#if defined(__GNUC__)
+        return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+        while(k & 1) k >>= 1;
+        return k >> 1;
+#endif
+    }
+
+    size_t rank(size_t k) const { return k ? rank_[k] : n_; }
+};
+
+/*
+ * Intervals sorted by low(), with the running maximum of high() so that a
+ * point or range query can stop scanning backwards as soon as no earlier
+ * interval can reach it. Intervals are [low, high), as in IBSTree.
+ */
+template <class ITYPE>
+class frozen_intervals {
+ public:
+    void build(std::set<ITYPE *> const& intervals) {
+        items_.assign(intervals.begin(), intervals.end());
+        std::sort(items_.begin(), items_.end(), [](ITYPE *a, ITYPE *b) {
+            return a->low() < b->low() || (a->low() == b->low() && a->high() < b->high());
+        });
+        std::vector<Address> lows;
+        lows.reserve(items_.size());
+        reach_.reserve(items_.size());
+        Address reach = 0;
+        for(auto *i : items_) {
+            lows.push_back(i->low());
+            if(i->high() > reach) reach = i->high();
+            reach_.push_back(reach);
+        }
+        lows_.build(lows);
+    }
+
+    // Intervals containing x
+    void find(Address x, std::set<ITYPE *> &out) const {
+        for(size_t i = lows_.upper_bound(x); i-- > 0 && reach_[i] > x; ) {
+            if(items_[i]->high() > x) out.insert(items_[i]);
+        }
+    }
+
+    // Intervals overlapping [start, end)
+    void find(Address start, Address end, std::set<ITYPE *> &out) const {
+        for(size_t i = lows_.lower_bound(end); i-- > 0 && reach_[i] > start; ) {
+            if(items_[i]->high() > start) out.insert(items_[i]);
+        }
+    }
+
+    // The interval containing x with the lowest high(), if any; otherwise
+    // the first interval starting after x. NULL if neither exists.
+    ITYPE *successor(Address x) const {
+        ITYPE *best = NULL;
+        size_t next = lows_.upper_bound(x);
+        for(size_t i = next; i-- > 0 && reach_[i] > x; ) {
+            if(items_[i]->high() > x && (!best || items_[i]->high() < best->high()))
+                best = items_[i];
+        }
+        if(!best && next < items_.size()) best = items_[next];
+        return best;
+    }
+
+ private:
+    eytzinger_index lows_;
+    std::vector<ITYPE *> items_;
+    std::vector<Address> reach_;
+};
+
+}
+}
+
+#endif
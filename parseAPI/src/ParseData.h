@@ -32,6 +32,9 @@
 
 #include "common/src/vgannotations.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 #include <map>
@@ -44,6 +47,7 @@
 #include "CodeObject.h"
 #include "CFG.h"
 #include "ParserDetails.h"
+#include "FrozenLookup.h"
 #include "debug_parse.h"
 
 #include <boost/thread/locks.hpp>
@@ -184,6 +188,33 @@ class edge_parsing_data {
 /* per-CodeRegion parsing data */
 class region_data {
 public:
+    /*
+     * Flat, sorted copies of the lookup tables below, built by freeze()
+     * once the CFG is finalized. While present, lookups read them without
+     * taking any lock. Every change to the tables calls thaw() first, which
+     * drops them. Dropped tables are freed once no lookup that may have
+     * loaded them is still running; see read_guard.
+     */
+    struct frozen_tables {
+        eytzinger_index func_addrs;
+        std::vector<Function *> funcs;
+        eytzinger_index block_addrs;
+        std::vector<Block *> blocks;
+        frozen_intervals<FuncExtent> func_ranges;
+        frozen_intervals<Block> block_ranges;
+    };
+
+    region_data() = default;
+    ~region_data();
+    region_data(region_data const&) = delete;
+    region_data& operator=(region_data const&) = delete;
+
+    void freeze();
+    bool frozen() const { return frozen_.load(std::memory_order_acquire) != NULL; }
+    void thaw() {
+        if(frozen_.load(std::memory_order_relaxed)) thaw_tables();
+    }
+
     // Function lookups
     Dyninst::IBSTree_fast<FuncExtent> funcsByRange;
     dyn_c_hash_map<Address, Function *> funcsByAddr;
@@ -214,8 +245,10 @@ public:
     {
         Block * nextBlock = NULL;
         Address nextBlockAddr = numeric_limits<Address>::max();
+        read_guard g(*this);
+        frozen_tables const* ft = g.tables();
 
-        if((nextBlock = blocksByRange.successor(addr)) &&
+        if((nextBlock = ft ? ft->block_ranges.successor(addr) : blocksByRange.successor(addr)) &&
            nextBlock->start() > addr)
         {
             nextBlockAddr = nextBlock->start();   
@@ -261,12 +294,14 @@ public:
     }
 
     Function* record_func(Function* f) {
+      thaw();
       if (funcsByAddr.insert(std::make_pair(f->addr(), f))) {
           return f;
       }
       return NULL;
     }
     Block* record_block(Block* b) {
+        thaw();
         Block* ret = NULL;
         {
             dyn_c_hash_map<Address, Block*>::accessor a;
@@ -281,6 +316,7 @@ public:
         return ret;
     }
     void insertBlockByRange(Block* b) {
+        thaw();
         blocksByRange.insert(b);
     }
 	 // Find functions within [start,end)
@@ -311,6 +347,46 @@ public:
 
     int getTotalNumOfBlocks() { return blocksByAddr.size(); }
 
+private:
+    /*
+     * Lookups count themselves in one of a few padded counters, picked
+     * per thread, from before they load frozen_ until they are done with
+     * the tables. Tables taken out of frozen_ can be freed whenever every
+     * counter reads zero afterwards, as any later lookup finds the new
+     * value of frozen_.
+     */
+    static constexpr unsigned num_reader_slots = 16;
+    struct reader_slot {
+        std::atomic<unsigned> count{0};
+        char pad[64 - sizeof(std::atomic<unsigned>)];
+    };
+    static unsigned reader_slot_index();
+
+    class read_guard {
+    public:
+        explicit read_guard(region_data const& rd) :
+            slot_(rd.readers_[reader_slot_index()])
+        {
+            slot_.count.fetch_add(1);
+            tables_ = rd.frozen_.load();
+        }
+        ~read_guard() { slot_.count.fetch_sub(1, std::memory_order_release); }
+        read_guard(read_guard const&) = delete;
+        read_guard& operator=(read_guard const&) = delete;
+
+        frozen_tables const* tables() const { return tables_; }
+    private:
+        reader_slot& slot_;
+        frozen_tables const* tables_;
+    };
+
+    std::atomic<frozen_tables const*> frozen_{};
+    mutable reader_slot readers_[num_reader_slots];
+    std::vector<std::unique_ptr<frozen_tables const>> retired_;
+    std::mutex retired_lock_;
+
+    void thaw_tables();
+    void reclaim_retired();
 };
 
 /** region_data inlines **/
@@ -318,6 +394,11 @@ public:
 inline Function *
 region_data::findFunc(Address entry)
 {
+    read_guard g(*this);
+    if(frozen_tables const* ft = g.tables()) {
+        size_t i = ft->func_addrs.find(entry);
+        return i == eytzinger_index::npos ? NULL : ft->funcs[i];
+    }
     Function *result = NULL;
     {
       dyn_c_hash_map<Address, Function *>::const_accessor a;
@@ -328,6 +409,11 @@ region_data::findFunc(Address entry)
 inline Block *
 region_data::findBlock(Address entry)
 {
+    read_guard g(*this);
+    if(frozen_tables const* ft = g.tables()) {
+        size_t i = ft->block_addrs.find(entry);
+        return i == eytzinger_index::npos ? NULL : ft->blocks[i];
+    }
     Block *result = NULL;
     {
       dyn_c_hash_map<Address, Block *>::const_accessor a;
@@ -343,7 +429,11 @@ region_data::findFuncs(Address addr, set<Function *> & funcs)
     set<FuncExtent *> extents;
     set<FuncExtent *>::iterator eit;
     
-    funcsByRange.find(addr,extents);
+    read_guard g(*this);
+    if(frozen_tables const* ft = g.tables())
+        ft->func_ranges.find(addr,extents);
+    else
+        funcsByRange.find(addr,extents);
     for(eit = extents.begin(); eit != extents.end(); ++eit)
         funcs.insert((*eit)->func());
  
@@ -358,7 +448,11 @@ region_data::findFuncs(Address start, Address end, set<Function *> & funcs)
     set<FuncExtent *> extents;
     set<FuncExtent *>::iterator eit;
     
-    funcsByRange.find(&dummy,extents);
+    read_guard g(*this);
+    if(frozen_tables const* ft = g.tables())
+        ft->func_ranges.find(start,end,extents);
+    else
+        funcsByRange.find(&dummy,extents);
     for(eit = extents.begin(); eit != extents.end(); ++eit)
         funcs.insert((*eit)->func());
  
@@ -368,7 +462,11 @@ inline int
 region_data::findBlocks(Address addr, set<Block *> & blocks)
 {
     int sz = blocks.size();
-    blocksByRange.find(addr,blocks);
+    read_guard g(*this);
+    if(frozen_tables const* ft = g.tables())
+        ft->block_ranges.find(addr,blocks);
+    else
+        blocksByRange.find(addr,blocks);
     return blocks.size() - sz;
 }
 
@@ -414,6 +512,9 @@ class ParseData {
     virtual void remove_block(Block *) =0;
     virtual void remove_extents(const std::vector<FuncExtent*> &extents) =0;
 
+    // moves the parse data of a region to its replacement
+    virtual void replace_region(CodeRegion *, CodeRegion *) =0;
+
     // does the Right Thing(TM) for standard- and overlapping-region 
     // object types
     virtual CodeRegion * reglookup(CodeRegion *cr, Address addr) =0;
@@ -455,6 +556,7 @@ class StandardParseData : public ParseData {
     void remove_func(Function *);
     void remove_block(Block *);
     void remove_extents(const std::vector<FuncExtent*> &extents);
+    void replace_region(CodeRegion *, CodeRegion *) { }
 
     CodeRegion * reglookup(CodeRegion *cr, Address addr);
     edge_parsing_data setEdgeParsingStatus(CodeRegion *cr, Address addr, Function *f, Block *b); 
@@ -524,6 +626,7 @@ class OverlappingParseData : public ParseData {
     void remove_func(Function *);
     void remove_block(Block *);
     void remove_extents(const std::vector<FuncExtent*> &extents);
+    void replace_region(CodeRegion *, CodeRegion *);
 
     CodeRegion * reglookup(CodeRegion *cr, Address addr);
     edge_parsing_data setEdgeParsingStatus(CodeRegion *cr, Address addr, Function* f, Block *b); 
@@ -0,0 +1,100 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef _PARSE_SCHEDULER_H_
+#define _PARSE_SCHEDULER_H_
+
+#include <functional>
+#include <vector>
+
+namespace Dyninst {
+namespace ParseAPI {
+
+class ParseFrame;
+
+/*
+ * Drives the parse frame worklist. run() hands every frame in `frames' to
+ * `process', along with the frames that processing produces, until no work
+ * remains. A frame may be handed out more than once; the parser tolerates
+ * this through the frame lock and status.
+ *
+ * Two schedulers are available:
+ *
+ *   steal  per-thread deques with work stealing (default)
+ *   omp    one OpenMP task per frame
+ *
+ * DYNINST_PARSE_SCHEDULER selects one by name and DYNINST_PARSE_THREADS
+ * sets the default thread count. Zero threads means the OpenMP default.
+ */
+class ParseScheduler {
+ public:
+    typedef std::vector<ParseFrame *> frame_list;
+    typedef std::function<void(ParseFrame *, frame_list &)> process_fn;
+
+    static ParseScheduler *create();
+
+    virtual ~ParseScheduler() = default;
+
+    virtual void run(frame_list &frames, process_fn const &process) = 0;
+
+    void set_threads(unsigned n) { num_threads = n; }
+    unsigned requested_threads() const { return num_threads; }
+
+    // The number of threads a parallel region should use; never zero
+    unsigned threads() const;
+
+ protected:
+    ParseScheduler();
+
+ private:
+    unsigned num_threads;
+};
+
+class OpenMPTaskScheduler : public ParseScheduler {
+ public:
+    void run(frame_list &frames, process_fn const &process) override;
+};
+
+/*
+ * Each thread owns a deque. Frames a thread produces go onto the back of its
+ * own deque and are taken from the back again, so a callee is usually parsed
+ * by the thread that found its call site. Idle threads steal from the front
+ * of other deques, taking up to half of the victim's frames at once as long
+ * as they belong to the same CodeRegion as the first.
+ */
+class WorkStealingScheduler : public ParseScheduler {
+ public:
+    void run(frame_list &frames, process_fn const &process) override;
+};
+
+}
+}
+
+#endif
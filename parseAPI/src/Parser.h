@@ -41,6 +41,7 @@
 #include "IBSTree.h"
 
 #include "LockFreeQueue.h"
+#include "ParseScheduler.h"
 
 #include "IA_IAPI.h"
 #include "InstructionAdapter.h"
@@ -53,6 +54,7 @@
 #include <boost/thread/lockable_adapter.hpp>
 #include <boost/thread/shared_mutex.hpp>
 #include <unordered_map>
+#include <memory>
 
 using namespace std;
 
@@ -114,6 +116,9 @@ namespace Dyninst {
         UNPARSEABLE     // error condition
     };
     ParseState _parse_state;
+
+    // drives the frame worklist in parse_frames
+    std::unique_ptr<ParseScheduler> scheduler{ParseScheduler::create()};
         public:
             Parser(CodeObject &obj, CFGFactory &fact, ParseCallbackManager &pcb);
 
@@ -178,7 +183,18 @@ namespace Dyninst {
 
             ParseData *parse_data() { return _parse_data; }
 
+            /** Persistent CFG cache (Parser-cfgcache.C) **/
+            std::string cfg_cache_file(std::string const& dir) const;
+
+            bool save_cfg_cache(std::string const& path);
+
+            bool load_cfg_cache(std::string const& path);
+
         private:
+            bool load_cfg_cache(const char *base, unsigned long size);
+
+            uint64_t cfg_cache_options() const;
+
             void parse_vanilla();
             void cleanup_frames();
             void parse_gap_heuristic(CodeRegion *cr);
@@ -260,6 +276,7 @@ namespace Dyninst {
             void finalize_funcs(dyn_c_vector<Function *> &funcs);
 	    void clean_bogus_funcs(dyn_c_vector<Function*> &funcs);
             void finalize_ranges();
+            void freeze_lookups();
             void finalize_jump_tables();
             void delete_bogus_blocks(Edge*);
             bool set_edge_parsing_status(ParseFrame&, Address addr, Block *b);
@@ -280,12 +297,8 @@ namespace Dyninst {
 
     LockFreeQueueItem<ParseFrame *> *ProcessOneFrame(ParseFrame *pf, bool recursive);
 
-    void SpawnProcessFrame(ParseFrame *frame, bool recursive);
-
     void ProcessFrames(LockFreeQueue<ParseFrame *> *work_queue, bool recursive);
 
-    void LaunchWork(LockFreeQueueItem<ParseFrame*> *frame_list, bool recursive);
-
 
     void processCycle(LockFreeQueue<ParseFrame *> &work, bool recursive);
 
@@ -33,6 +33,8 @@
 #include "Event.h"
 #include "dyninst_visibility.h"
 
+#include <vector>
+
 namespace Dyninst {
 namespace ProcControlAPI {
 
@@ -48,6 +50,7 @@ public:
    virtual ~Mailbox();
 
    virtual void enqueue(Event::ptr ev, bool priority = false) = 0;
+   virtual void enqueue_batch(const std::vector<Event::ptr> &evs);
    virtual void enqueue_user(Event::ptr ev) = 0;
    virtual bool hasPriorityEvent() = 0;
    virtual Event::ptr dequeue(bool block) = 0;
@@ -151,6 +151,7 @@ const err_t err_attached       = 0x10011;
 const err_t err_pendingirpcs   = 0x10012;
 const err_t err_bpfull         = 0x10013;
 const err_t err_notfound       = 0x10014;
+const err_t err_procwrite      = 0x10015;
 const err_t err_dstack         = 0x10107;
 const err_t err_eof            = 0x10108;
 
@@ -269,6 +269,11 @@ class DYNINST_EXPORT IRPC
    unsigned long getStartOffset() const;
    bool isBlocking() const;
 
+   // Registers as this IRPC left them, for IRPCs run by postIRPCBatch.
+   // Returns false for other IRPCs; read those with Thread::getRegister
+   // from the completion callback.
+   bool getResultRegister(Dyninst::MachRegister reg, Dyninst::MachRegisterVal &val) const;
+
    // user-defined data retrievable during a callback
    void *getData() const;
    void setData(void *p) const;
@@ -471,6 +476,32 @@ class DYNINST_EXPORT Process : public boost::enable_shared_from_this<Process>
    bool writeMemoryAsync(Dyninst::Address addr, const void *buffer, size_t size, void *opaque_val = NULL) const;
    bool readMemoryAsync(void *buffer, Dyninst::Address addr, size_t size, void *opaque_val = NULL) const;
 
+   /**
+    * Scatter/gather memory access.  Each segment is transferred independently
+    * and has its 'err' field set to err_none on success, or err_procread or
+    * err_procwrite on a failed read or write.  Reads that fall close
+    * together in the target are coalesced into fewer system calls.  Returns
+    * false if any segment failed.
+    **/
+   struct mem_segment_t {
+      Dyninst::Address addr;
+      void *buffer;
+      size_t size;
+      err_t err;
+   };
+   bool readMemoryV(std::vector<mem_segment_t> &segments) const;
+   bool writeMemoryV(std::vector<mem_segment_t> &segments) const;
+
+   /**
+    * Opt-in read cache.  While every thread is stopped, readMemory and
+    * readMemoryV are served from page-sized copies of target memory.  The
+    * copies are dropped on continue, on writes, and after iRPCs.  Hits and
+    * misses count pages.
+    **/
+   bool setMemoryReadCache(bool enable) const;
+   bool isMemoryReadCacheEnabled() const;
+   bool getMemoryReadCacheStats(unsigned long &hits, unsigned long &misses) const;
+
    /** 
     * Currently Windows-only, needed for the test infrastructure but possibly useful elsewhere 
     **/
@@ -507,6 +538,17 @@ class DYNINST_EXPORT Process : public boost::enable_shared_from_this<Process>
    bool postIRPC(IRPC::ptr irpc) const;
    bool getPostedIRPCs(std::vector<IRPC::ptr> &rpcs) const;
 
+   /**
+    * Post IRPCs to run back-to-back on one thread.  On x86_64, when each
+    * IRPC's code ends in a trap, they are fused into one blob that takes a
+    * single stop and continue: each later IRPC starts with the registers
+    * the previous one left, so each must leave the stack as it found it.
+    * Every IRPC still gets its own completion callback, delivered after the
+    * whole batch has run; use IRPC::getResultRegister for its results.
+    * Otherwise the IRPCs are posted one after another to the same thread.
+    **/
+   bool postIRPCBatch(const std::vector<IRPC::ptr> &irpcs) const;
+
    /**
     * Post, run, and wait for an IRPC to complete
     **/
@@ -626,6 +668,7 @@ class DYNINST_EXPORT Thread : public boost::enable_shared_from_this<Thread>
     * IRPC
     **/
    bool postIRPC(IRPC::ptr irpc) const;
+   bool postIRPCBatch(const std::vector<IRPC::ptr> &irpcs) const;
    bool runIRPCSync(IRPC::ptr irpc);
    bool runIRPCAsync(IRPC::ptr irpc);
 
@@ -217,6 +217,27 @@ class DYNINST_EXPORT ProcessSet : public boost::enable_shared_from_this<ProcessS
    };
    static ProcessSet::ptr attachProcessSet(std::vector<AttachInfo> &ainfo);
 
+   /**
+    * Seconds spent in each phase of an attach.  Every phase is issued
+    * across all processes before the next phase starts.
+    **/
+   struct AttachTimings {
+      double attach;      //Issuing the ptrace attach to each process
+      double stop;        //Waiting for every process to stop
+      double threads;     //Attaching to and stopping each process's threads
+      double post_attach; //Library discovery and thread_db setup
+   };
+
+   /**
+    * With defer_init set, library discovery and thread_db setup are skipped
+    * during the attach.  They run the first time a process's libraries,
+    * user-level thread information, or thread-local storage is asked for,
+    * including through AddressSet and ThreadSet.  Library events seen
+    * before then are delivered afterwards.
+    **/
+   static ProcessSet::ptr attachProcessSet(std::vector<AttachInfo> &ainfo, bool defer_init,
+                                           AttachTimings *timings = NULL);
+
    /**
     * Return a new set by performing these set operations with another set.
     **/
@@ -366,6 +387,9 @@ class DYNINST_EXPORT ProcessSet : public boost::enable_shared_from_this<ProcessS
    bool readMemory(AddressSet::ptr addr, std::multimap<Process::ptr, void *> &result, size_t size) const;
    bool readMemory(AddressSet::ptr addr, std::map<void *, ProcessSet::ptr> &result, size_t size, bool use_checksum = true) const;
    bool readMemory(std::multimap<Process::const_ptr, read_t> &addrs) const;
+   // Like the read_t form above, but all reads for a process are issued as
+   // a single vectored request (see Process::readMemoryV).
+   bool readMemoryV(std::multimap<Process::const_ptr, read_t> &addrs) const;
 
    bool writeMemory(AddressSet::ptr addr, const void *buffer, size_t size) const;
    bool writeMemory(std::multimap<Process::const_ptr, write_t> &addrs) const;
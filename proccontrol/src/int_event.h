@@ -96,6 +96,8 @@ class int_eventRPC {
    reg_response::ptr alloc_regresult;
    result_response::ptr memrestore_response;
    result_response::ptr regrestore_response;
+   mem_response::ptr batch_response;
+   std::vector<char> batch_slots;
 
    void getPendingAsyncs(std::set<response::ptr> &pending);
 };
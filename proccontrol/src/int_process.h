@@ -270,7 +270,8 @@ class int_process
    virtual bool plat_create() = 0;
    virtual async_ret_t post_create(std::set<response::ptr> &async_responses);
 
-   static bool attach(int_processSet *ps, bool reattach);
+   static bool attach(int_processSet *ps, bool reattach,
+                      ProcessSet::AttachTimings *timings = NULL);
    static bool reattach(int_processSet *pset);
    virtual bool plat_attach(bool allStopped, bool &should_sync) = 0;
 
@@ -281,6 +282,10 @@ class int_process
    virtual async_ret_t post_attach(bool wasDetached, std::set<response::ptr> &aresps);
    async_ret_t initializeAddressSpace(std::set<response::ptr> &async_responses);
 
+   //Stop the process, if needed, around a deferred initialization
+   bool stopForDeferredInit();
+   void continueAfterDeferredInit();
+
    virtual bool plat_syncRunState() = 0;
    bool syncRunState();
 
@@ -297,6 +302,14 @@ class int_process
    int getContSignal() const;
    virtual bool forked();
 
+   //Library discovery and thread_db setup skipped by a deferred attach.
+   // These run it on first use and are no-ops otherwise.  Library events
+   // that arrive before then are queued and replayed afterwards.
+   void setDeferredInit(bool b);
+   bool initDeferredLibraries();
+   virtual bool initDeferredThreads();
+   bool deferLibraryEvent(Event::ptr ev);
+
    virtual OSType getOS() const = 0;
   protected:
    virtual bool plat_forked() = 0;
@@ -438,6 +451,15 @@ class int_process
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write) = 0;
 
+   //Vectored forms of readMem/writeMem.  These are synchronous and set the
+   // err field of each segment.  Platforms that can batch transfers should
+   // override plat_readMemV/plat_writeMemV; the defaults loop over
+   // plat_readMem/plat_writeMem.
+   bool readMemV(std::vector<Process::mem_segment_t> &segs, int_thread *thr = NULL);
+   bool writeMemV(std::vector<Process::mem_segment_t> &segs, int_thread *thr = NULL);
+   virtual void plat_readMemV(int_thread *thr, std::vector<Process::mem_segment_t> &segs);
+   virtual void plat_writeMemV(int_thread *thr, std::vector<Process::mem_segment_t> &segs);
+
    virtual async_ret_t plat_calcTLSAddress(int_thread *thread, int_library *lib, Offset off,
                                            Address &outaddr, std::set<response::ptr> &resps);
 
@@ -472,6 +494,7 @@ class int_process
                                                Process::MemoryRegion& memRegion);
 
    memCache *getMemCache();
+   pageCache *getPageCache();
 
    virtual bool plat_getOSRunningStates(std::map<Dyninst::LWP, bool> &runningStates) = 0;
 	// Windows-only technically
@@ -575,6 +598,7 @@ class int_process
    int continueSig;
    bool createdViaAttach;
    memCache mem_cache;
+   pageCache page_cache;
    Counter async_event_count;
    Counter force_generator_block_count;
    Counter startupteardown_procs;
@@ -585,6 +609,9 @@ class int_process
    const char *last_error_string;
    SymbolReaderFactory *symbol_reader;
    static SymbolReaderFactory *user_set_symbol_reader;
+   bool deferred_libs;
+   bool deferred_threads;
+   std::vector<Event::ptr> deferred_lib_events;
 
    //Cached PlatFeature pointers, which are used to avoid slow dynamic casts
    // (they're used frequently in tight loops on BG/Q)
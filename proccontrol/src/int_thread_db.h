@@ -107,6 +107,7 @@ public:
      */
     virtual async_ret_t post_attach(bool wasDetached, std::set<response::ptr> &aresps);
     virtual async_ret_t post_create(std::set<response::ptr> &async_responses);
+    virtual bool initDeferredThreads();
 
     virtual bool plat_supportThreadEvents();
 
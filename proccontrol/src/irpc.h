@@ -148,7 +148,9 @@ class int_iRPC : public boost::enable_shared_from_this<int_iRPC>
    bool isInternalRPC() const;
 
    unsigned long allocSize() const;
+   unsigned long allocNeeded() const;
    Dyninst::Address addr() const;
+   Dyninst::Address codeAddr() const;
    bool hasSavedRegs() const;
    bool userAllocated() const;
    bool shouldSaveData() const;
@@ -185,6 +187,16 @@ class int_iRPC : public boost::enable_shared_from_this<int_iRPC>
    void setDirectFree(bool s) { directFree_ = s; }
    bool directFree() const { return directFree_; }
 
+   //A batch runs as one fused blob carried by its first member: each
+   // member's code is followed by stores of the registers into its own
+   // result slot, and the blob traps once at the end.
+   bool isBatchHead() const;
+   bool isBatchMember() const;
+   Dyninst::Address batchSlotsAddr() const;
+   unsigned long batchSlotsSize() const;
+   bool finishBatch(const char *slots, Event::ptr ev);
+   bool batchResult(Dyninst::MachRegister reg, Dyninst::MachRegisterVal &val) const;
+
    void getPendingResponses(std::set<response::ptr> &resps);
    void syncAsyncResponses(bool is_sync);
 
@@ -224,6 +236,13 @@ class int_iRPC : public boost::enable_shared_from_this<int_iRPC>
    result_response::ptr pcset_result;
    bool directFree_;
    void *user_data;
+
+   unsigned long batch_offset;
+   unsigned long batch_slots;
+   std::vector<unsigned char> batch_blob;
+   std::vector<int_iRPC::ptr> batch_members;
+   bool batch_member;
+   std::vector<Dyninst::MachRegisterVal> batch_result;
 };
 
 //Singleton class, only one of these across all processes.
@@ -240,6 +259,7 @@ class iRPCMgr
    
    bool postRPCToProc(int_process *proc, int_iRPC::ptr rpc);
    bool postRPCToThread(int_thread *thread, int_iRPC::ptr rpc);
+   bool postRPCBatch(int_process *proc, int_thread *thread, const std::vector<int_iRPC::ptr> &rpcs);
    int_thread *createThreadForRPC(int_process* proc, int_thread* best_candidate);
 
    int_iRPC::ptr createInfMallocRPC(int_process *proc, unsigned long size, bool use_addr, Dyninst::Address addr);
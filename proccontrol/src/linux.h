@@ -71,6 +71,7 @@ class GeneratorLinux : public GeneratorMT
    virtual bool initialize();
    virtual bool canFastHandle();
    virtual ArchEvent *getEvent(bool block);
+   virtual bool getMultiEvent(bool block, std::vector<ArchEvent *> &events);
    void evictFromWaitpid();
 };
 
@@ -137,6 +138,8 @@ class linux_process : public sysv_process, public unix_process, public thread_db
                              Dyninst::Address remote, size_t size);
    virtual bool plat_writeMem(int_thread *thr, const void *local,
                               Dyninst::Address remote, size_t size, bp_write_t bp_write);
+   virtual void plat_readMemV(int_thread *thr, std::vector<Process::mem_segment_t> &segs);
+   virtual void plat_writeMemV(int_thread *thr, std::vector<Process::mem_segment_t> &segs);
    virtual SymbolReaderFactory *plat_defaultSymReader();
    virtual bool needIndividualThreadAttach();
    virtual bool getThreadLWPs(std::vector<Dyninst::LWP> &lwps);
@@ -162,6 +165,8 @@ class linux_process : public sysv_process, public unix_process, public thread_db
 
   protected:
    int computeAddrWidth();
+   bool readMemFallback(int_thread *thr, void *local, Dyninst::Address remote, size_t size);
+   bool writeMemFallback(int_thread *thr, const void *local, Dyninst::Address remote, size_t size);
 };
 
 class linux_x86_process : public linux_process, public x86_process
@@ -32,10 +32,12 @@
 #define MEMCACHE_H_
 
 #include "common/h/dyntypes.h"
+#include "common/src/dthread.h"
 #include "response.h"
 #include <vector>
 #include <set>
 #include <map>
+#include <unordered_map>
 
 class int_process;
 
@@ -169,4 +171,35 @@ class memCache {
                                int_thread *writing_thrd = NULL);
 };
 
+/**
+ * Unlike the memCache above, the pageCache is a plain read cache for
+ * general use.  It keeps page-sized copies of target memory while every
+ * thread in the process is stopped, and must be cleared whenever the
+ * target's memory could change: on continue, on writes, after iRPCs, and
+ * across exec or detach.  It is off unless the user enables it.
+ **/
+class pageCache {
+  private:
+   int_process *proc;
+   std::unordered_map<Dyninst::Address, std::vector<char> > pages;
+   Mutex<> lock;
+   bool enabled;
+   unsigned long hits;
+   unsigned long misses;
+
+  public:
+   pageCache(int_process *p);
+
+   void setEnabled(bool b);
+   bool isEnabled() const;
+   bool isUsable();
+
+   //Fills the segments from cached pages, reading any missing pages first.
+   // Segments on pages that cannot be read whole are read directly.
+   void readMemV(int_thread *thr, std::vector<Dyninst::ProcControlAPI::Process::mem_segment_t> &segs);
+   void invalidate(Dyninst::Address addr, unsigned long size);
+   void clear();
+   void getStats(unsigned long &hits_, unsigned long &misses_, unsigned long &pages_);
+};
+
 #endif
@@ -32,6 +32,8 @@
 #define SYMLOOKUP_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 #include "basetypes.h"
 
 namespace Dyninst {
@@ -39,6 +41,8 @@ namespace Stackwalker {
 
 class Walker;
 class ProcessState;
+class Frame;
+class int_symbolizer;
 
 class DYNINST_EXPORT SymbolLookup {
   friend class Walker;
@@ -76,6 +80,39 @@ class SymDefaultLookup : public SymbolLookup {
     virtual ~SymDefaultLookup();
 };
 
+struct DYNINST_EXPORT SymbolInfo {
+   std::string name;
+   std::string file;   //Empty if there is no line information
+   unsigned line;
+   bool found;
+   SymbolInfo() : line(0), found(false) {}
+};
+
+//Resolves many addresses at once.  Symbol readers come from the
+// process-wide library cache shared with every Walker, so a library
+// mapped by many processes is read once.  A Symbolizer holds a reference
+// on each library it uses until it is destroyed, and remembers every
+// address it has resolved.  Use one Symbolizer per thread.
+class DYNINST_EXPORT Symbolizer {
+  private:
+   int_symbolizer *isymbolizer;
+  public:
+   typedef std::pair<std::string, Dyninst::Offset> LibOffset;
+
+   Symbolizer(bool line_info = true);
+   ~Symbolizer();
+   Symbolizer(const Symbolizer &) = delete;
+   Symbolizer &operator=(const Symbolizer &) = delete;
+
+   //Fills out[i] for addrs[i].  Returns false if any address was not found.
+   bool lookup(const std::vector<LibOffset> &addrs, std::vector<SymbolInfo> &out);
+
+   //As above, for the call site of each frame.  Names come from the
+   // SymbolLookup installed in each frame's Walker, through
+   // Frame::getName, so later calls to it do no work.
+   bool lookup(const std::vector<Frame> &frames, std::vector<SymbolInfo> &out);
+};
+
 }
 }
 
@@ -194,6 +194,13 @@ class DYNINST_EXPORT WalkerSet {
    size_t size() const;
 
    bool walkStacks(CallTree &tree, bool walk_initial_only = false) const;
+
+   //Number of threads walkStacks unwinds processes on, when every walker
+   // is for a ProcDebug process on a platform without OS supported
+   // unwinding.  Other sets are walked on the calling thread.  0 (the
+   // default) uses DYNINST_STACKWALK_THREADS if set, else one per core.
+   void setWalkThreads(unsigned num_threads);
+   unsigned getWalkThreads() const;
 };
 
 }
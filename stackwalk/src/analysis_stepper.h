@@ -80,6 +80,7 @@ class AnalysisStepperImpl : public FrameStepper
    static std::map<std::string, ParseAPI::CodeSource*> srcs;
    static std::map<std::string, SymReader*> readers;
    
+   //Callers hold analysis_lock
    static ParseAPI::CodeObject *getCodeObject(std::string name);
    static ParseAPI::CodeSource *getCodeSource(std::string name);
 
@@ -39,6 +39,8 @@ namespace Dyninst {
 namespace DwarfDyninst {
 class DwarfFrameParser;
 typedef boost::shared_ptr<DwarfFrameParser> DwarfFrameParserPtr;
+class UnwindTable;
+struct UnwindRule;
 }
 
 namespace Stackwalker {
@@ -82,6 +84,11 @@ class DebugStepperImpl : public FrameStepper, public Dyninst::ProcessReader {
  protected:
   gcframe_ret_t getCallerFrameArch(Address pc, const Frame &in, Frame &out, 
                                    DwarfDyninst::DwarfFrameParserPtr dinfo, bool isVsyscallPage);
+  gcframe_ret_t getCallerFrameFromTable(Address pc, const Frame &in, Frame &out,
+                                        const DwarfDyninst::UnwindTable &table,
+                                        MachRegister frame_reg);
+  bool applyUnwindRule(const DwarfDyninst::UnwindRule &rule, Address cfa,
+                       MachRegister same_reg, MachRegisterVal &val, location_t &loc);
   bool isFrameRegister(MachRegister reg);
   bool isStackRegister(MachRegister reg);
 };
@@ -35,6 +35,7 @@
 #include "common/h/SymReader.h"
 #include "stackwalk/h/procstate.h"
 #include "common/src/addrtranslate.h"
+#include "concurrent.h"
 #include <map>
 #include <string>
 #include <utility>
@@ -95,13 +96,28 @@ class StaticBinaryLibState : public LibraryState {
 
 SymbolReaderFactory *getDefaultSymbolReader();
 
+// Process-wide cache of SymReaders.  Readers are shared by every name
+// that refers to the same file (device, inode, size and mtime), so a
+// library mapped by many processes is opened once.  getLibrary and
+// registerLibrary pin a reader for the life of the process;
+// openLibrary/closeLibrary count references, and an unpinned reader is
+// closed when its last reference goes away.
 class LibraryWrapper {
   private:
    std::map<std::string, SymReader *> file_map;
+   std::map<std::string, SymReader *> identity_map;
+   std::map<SymReader *, unsigned> ref_counts;
+   std::set<SymReader *> pinned;
+   dyn_mutex file_map_lock;
+
+   SymReader *lookup(const std::string &filename);
   public:
    static SymReader *testLibrary(std::string filename);
    static SymReader *getLibrary(std::string filename);
    static void registerLibrary(SymReader *reader, std::string filename);
+
+   static SymReader *openLibrary(std::string filename);
+   static void closeLibrary(SymReader *reader);
 };
 
 }
@@ -181,8 +181,12 @@ private:
    void clearProcSet();
    void initProcSet();
    bool walkStacksProcSet(CallTree &tree, bool &bad_plat, bool walk_iniital_only);
+   bool walkStacksBatched(CallTree &tree, bool walk_initial_only);
+   bool walkStacksParallel(CallTree &tree, bool walk_initial_only);
+   unsigned walkThreads() const;
 
    unsigned non_pd_walkers;
+   unsigned walk_threads;
    set<Walker *> walkers;
    void *procset; //Opaque pointer, will refer to a ProcControl::ProcessSet in some situations
 };
@@ -101,6 +101,18 @@ class DYNINST_EXPORT Symtab : public LookupInterface,
    public:
    static void version(int& major, int& minor, int& maintenance);
 
+   // Counters for the process-wide cache behind Symbol::getPrettyName and
+   // Symbol::getTypedName; its size is set with DYNINST_DEMANGLE_CACHE_SIZE.
+   struct DemangleCacheStats {
+      unsigned long hits;
+      unsigned long misses;
+      unsigned long evictions;
+      unsigned long entries;
+      unsigned long capacity;
+      unsigned long interned;
+   };
+   static DemangleCacheStats getDemangleCacheStats();
+
    Symtab();
 
    Symtab(unsigned char *mem_image, size_t image_size, 
@@ -117,8 +129,17 @@ class DYNINST_EXPORT Symtab : public LookupInterface,
       NotDefensive,
       Defensive} def_t; 
 
+   // With LazySymbols the static symbol table is kept as a compact sorted
+   // index and Symbol objects are only created once a lookup returns them.
+   // PersistentLazySymbols also reuses or writes the index next to the file.
+   typedef enum {
+      EagerSymbols,
+      LazySymbols,
+      PersistentLazySymbols} symload_t;
+
    static bool openFile(Symtab *&obj, std::string const& filename,
-                                      def_t defensive_binary = NotDefensive);
+                                      def_t defensive_binary = NotDefensive,
+                                      symload_t symbol_loading = EagerSymbols);
    static bool openFile(Symtab *&obj, void *mem_image, size_t size, 
                                       std::string const& name, def_t defensive_binary = NotDefensive);
    static Symtab *findOpenSymtab(std::string const& filename);
@@ -144,6 +165,30 @@ class DYNINST_EXPORT Symtab : public LookupInterface,
                                          bool checkCase = false,
                                          bool includeUndefined = false);
 
+   // One query of a batched symbol search. Wildcard patterns use '*' and
+   // '?' like findSymbol with isRegex; Regex patterns are ECMAScript regular
+   // expressions and match anywhere in a name unless anchored.
+   struct SymbolQuery {
+      typedef enum { Exact, Wildcard, Regex } syntax_t;
+
+      std::string pattern;
+      syntax_t syntax;
+      Symbol::SymbolType type;
+      NameType nameType;
+      bool checkCase;
+
+      SymbolQuery(std::string p, syntax_t s = Wildcard,
+                  Symbol::SymbolType t = Symbol::ST_UNKNOWN,
+                  NameType n = anyName, bool c = false)
+         : pattern(std::move(p)), syntax(s), type(t), nameType(n), checkCase(c) {}
+   };
+
+   // Answers all queries with a single pass over an index of the defined
+   // symbols' names; ret[i] receives the matches of queries[i]. Returns
+   // false if nothing matched or a regular expression is invalid.
+   bool findSymbols(std::vector<std::vector<Symbol *> > &ret,
+                    std::vector<SymbolQuery> const& queries);
+
    virtual bool getAllSymbols(std::vector<Symbol *> &ret);
    virtual bool getAllSymbolsByType(std::vector<Symbol *> &ret, 
          Symbol::SymbolType sType);
@@ -165,7 +210,7 @@ class DYNINST_EXPORT Symtab : public LookupInterface,
                                           bool isRegex = false,
                                           bool checkCase = true);
    bool getAllFunctions(std::vector<Function *>&ret);
-   const std::vector<Function*>& getAllFunctionsRef() const { return everyFunction; }
+   const std::vector<Function*>& getAllFunctionsRef() const;
 
    //Searches for functions without returning inlined instances
    bool getContainingFunction(Offset offset, Function* &func);
@@ -292,6 +337,15 @@ class DYNINST_EXPORT Symtab : public LookupInterface,
 
    void parseTypesNow();
 
+   // Parses the types, variables and inlines of 'mod' only, if lazy type
+   // parsing is on; otherwise the same as parseTypesNow().
+   void parseTypesNow(Module *mod);
+
+   // Defers DWARF parsing to the first query that needs a given module.
+   // ELF only, and must be set before anything has parsed types.
+   bool setLazyTypeParsing(bool lazy);
+   bool lazyTypeParsing() const;
+
    /***** Local Variable Information *****/
    bool findLocalVariable(std::vector<localVar *>&vars, std::string const& name);
 
@@ -394,7 +448,7 @@ class DYNINST_EXPORT Symtab : public LookupInterface,
    /***** Private Member Functions *****/
    private:
 
-   Symtab(std::string const& filename, bool defensive_bin, bool &err);
+   Symtab(std::string const& filename, bool defensive_bin, symload_t symbol_loading, bool &err);
 
    bool extractInfo(Object *linkedFile);
 
@@ -413,6 +467,13 @@ class DYNINST_EXPORT Symtab : public LookupInterface,
    bool addSymbolToAggregates(const Symbol *sym);
    bool doNotAggregate(const Symbol *sym);
 
+   // Lazy symbol loading (see SymbolIndex.h)
+   Symbol *materializeIndexedSymbol(unsigned i);
+   void materializeSymbolsByName(std::string const& name, NameType nameType);
+   void buildDemangledIndex();
+   void materializeSymbolsByOffset(Offset off);
+   void materializeAllSymbols() const;
+
 
    void setModuleLanguages(dyn_hash_map<std::string, supportedLanguages> *mod_langs);
 
@@ -455,6 +516,7 @@ class DYNINST_EXPORT Symtab : public LookupInterface,
    void parseLineInformation();
    
    void parseTypes();
+   void parseModuleTypes(Module *mod);
    bool setDefaultNamespacePrefix(std::string str);
 
    bool addUserRegion(Region *newreg);
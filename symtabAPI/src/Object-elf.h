@@ -46,6 +46,8 @@
 #include <assert.h>
 #include <ostream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <stddef.h>
 #include <unordered_map>
 #include <utility>
@@ -174,6 +176,7 @@ public:
   void getModuleLanguageInfo(dyn_hash_map<std::string, supportedLanguages> *mod_langs) override;
   void parseFileLineInfo() override;
   void parseTypeInfo() override;
+  void parseModuleTypeInfo(SymtabAPI::Module *mod) override;
   void addModule(SymtabAPI::Module* m) override;
 
   bool needs_function_binding() const override { return (plt_addr_ > 0); }
@@ -380,6 +383,11 @@ public:
   Dyninst::DwarfDyninst::DwarfHandle::ptr dwarf;
   private:
 
+  // Unit DIEs grouped by Module, for parseModuleTypeInfo
+  std::once_flag module_dies_once_;
+  std::map<SymtabAPI::Module *, std::vector<Dwarf_Die> > module_dies_;
+  std::shared_ptr<Dyninst::dyn_c_hash_map<FunctionBase *, bool> > lazy_parsed_funcs_;
+
   enum class ObjectType {
     Unknown,
     SharedLib,
@@ -479,6 +487,12 @@ private:
                      Elf_X_Shdr* symscnp,
                      Elf_X_Shdr* symtab_shndx_scnp,
                      bool shared_library);
+
+  // Builds symbol_index_ in place of parse_symbols for lazily-loaded Symtabs
+  bool index_symbols(Elf_X_Data &symdata, Elf_X_Data &strdata,
+                     Elf_X_Shdr* bssscnp,
+                     Elf_X_Shdr* symtab_shndx_scnp,
+                     bool persistent);
   
   void parse_dynamicSymbols( Elf_X_Shdr *& dyn_scnp, Elf_X_Data &symdata,
                              Elf_X_Data &strdata, bool shared_library);
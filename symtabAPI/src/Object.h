@@ -43,6 +43,7 @@
 
 // trace data streams
 #include <iosfwd>
+#include <memory>
 #include <utility>
 #include <string>
 #include <vector>
@@ -51,6 +52,7 @@
 #include "Symtab.h"
 #include "Module.h"
 #include "LineInformation.h"
+#include "SymbolIndex.h"
 #include "common/src/headers.h"
 #include "common/src/MappedFile.h"
 #include "common/src/lprintf.h"
@@ -181,6 +183,7 @@ public:
     virtual bool emitDriver(std::string fName, std::set<Symbol *> &allSymbols, unsigned flag) = 0;
     virtual void parseFileLineInfo() { }
     virtual void parseTypeInfo() { }
+    virtual void parseModuleTypeInfo(SymtabAPI::Module *) { }
 
     // Only implemented for ELF right now
     DYNINST_EXPORT virtual void getSegmentsSymReader(std::vector<SymSegment> &) {}
@@ -206,6 +209,10 @@ friend class Module;
     dyn_c_hash_map<Offset, std::vector<Symbol *> > symsByOffset_;
     std::vector<std::pair<std::string, Offset> > modules_;
 
+    // Set instead of symbols_ for the static symbol table when the
+    // Symtab loads its symbols lazily
+    std::unique_ptr<SymbolIndex> symbol_index_;
+
     char*   code_ptr_;
     Offset code_off_;
     Offset code_len_;
@@ -0,0 +1,142 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * SymbolIndex: a compact, sorted view of an object file's symbol table.
+ *
+ * Each symbol is described by a fixed-size Entry whose name is an
+ * offset into the object's own string table, so building the index
+ * copies no strings. Two permutation arrays order the entries by name
+ * and by offset for binary-searched lookups. Symtab uses the index to
+ * defer creating Symbol objects until a lookup actually returns them.
+ *
+ * The entries and permutations can be written to a side file and
+ * mapped back in place on a later run; the file is tied to the object
+ * it was built from by a Stamp and silently rejected on mismatch.
+ */
+
+#if !defined(SYMTAB_SYMBOL_INDEX_H)
+#define SYMTAB_SYMBOL_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dyntypes.h"
+
+class MappedFile;
+
+namespace Dyninst {
+namespace SymtabAPI {
+
+class SymbolIndex {
+  public:
+    enum entry_flags {
+        is_absolute = 0x1,
+        is_common = 0x2
+    };
+
+    struct Entry {
+        uint64_t offset;
+        uint64_t size;
+        uint32_t name;       // offset into the string table
+        uint32_t index;      // index in the file's symbol table
+        uint32_t section;    // section number
+        uint8_t type;        // Symbol::SymbolType
+        uint8_t linkage;     // Symbol::SymbolLinkage
+        uint8_t visibility;  // Symbol::SymbolVisibility
+        uint8_t raw_type;    // file-format symbol type
+        uint8_t flags;       // entry_flags
+        uint8_t pad[7];
+    };
+
+    // Identifies the object an index was built from
+    struct Stamp {
+        uint64_t file_size;
+        uint64_t mtime;
+        uint64_t num_symbols;
+        uint64_t strings_size;
+    };
+
+    typedef std::pair<const uint32_t *, const uint32_t *> range;
+
+    SymbolIndex(const char *strings, size_t strings_size);
+    ~SymbolIndex();
+
+    SymbolIndex(SymbolIndex const&) = delete;
+    SymbolIndex& operator=(SymbolIndex const&) = delete;
+
+    void add(Entry const& e) { entries_.push_back(e); }
+
+    // Builds the sorted permutations; no lookups before this.
+    void finalize();
+
+    bool save(std::string const& path, Stamp const& stamp) const;
+    bool load(std::string const& path, Stamp const& stamp);
+
+    size_t size() const { return count_; }
+    Entry const& entry(uint32_t i) const { return entries_ptr_[i]; }
+    const char *name(uint32_t i) const { return strings_ + entries_ptr_[i].name; }
+
+    // Entry indices (into entry()) whose name or offset matches
+    range findByName(std::string const& name) const;
+    range findByOffset(Offset off) const;
+    range findByPrefix(std::string const& prefix) const;
+
+    // Entry indices in name order, for scans over all names
+    range byName() const { return range(by_name_, by_name_ + count_); }
+
+    // Where the index for 'file' is persisted
+    static std::string indexFileFor(std::string const& file);
+
+  private:
+    const char *strings_;
+    size_t strings_size_;
+
+    // Storage for a freshly built index...
+    std::vector<Entry> entries_;
+    std::vector<uint32_t> name_order_;
+    std::vector<uint32_t> offset_order_;
+
+    // ...or for one mapped in from disk
+    MappedFile *mf_;
+
+    const Entry *entries_ptr_;
+    const uint32_t *by_name_;
+    const uint32_t *by_offset_;
+    size_t count_;
+};
+
+}
+}
+
+#endif
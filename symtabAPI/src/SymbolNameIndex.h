@@ -0,0 +1,98 @@
+/*
+ * See the dyninst/COPYRIGHT file for copyright information.
+ * 
+ * We provide the Paradyn Tools (below described as "Paradyn")
+ * on an AS IS basis, and do not warrant its validity or performance.
+ * We reserve the right to update, modify, or discontinue this
+ * software at any time.  We shall have no obligation to supply such
+ * updates or modifications or any other form of support to you.
+ * 
+ * By your use of Paradyn, you understand and agree that we (or any
+ * other person or entity with proprietary rights in Paradyn) are
+ * under no obligation to provide either maintenance services,
+ * update services, notices of latent defects, or correction of
+ * defects for Paradyn.
+ * 
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * 
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/*
+ * SymbolNameIndex: answers wildcard and regular-expression symbol
+ * lookups without testing every name.
+ *
+ * Every mangled, pretty and typed name of the defined symbols is stored
+ * once in a sorted array, next to the symbols (and name kinds) that carry
+ * it. A query's literal prefix selects a range of that array, and each
+ * literal run of three or more characters selects the names containing
+ * its (case-folded) trigrams. Only names in the intersection are matched
+ * against the pattern; queries with no usable literal fall back to a scan
+ * of the unique names, shared by all such queries of a batch.
+ *
+ * The index is immutable; Symtab drops it whenever its symbols change.
+ */
+
+#if !defined(SYMTAB_SYMBOL_NAME_INDEX_H)
+#define SYMTAB_SYMBOL_NAME_INDEX_H
+
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Symtab.h"
+
+namespace Dyninst {
+namespace SymtabAPI {
+
+class SymbolNameIndex {
+  public:
+    explicit SymbolNameIndex(std::vector<Symbol *> const& syms);
+
+    SymbolNameIndex(SymbolNameIndex const&) = delete;
+    SymbolNameIndex& operator=(SymbolNameIndex const&) = delete;
+
+    // Appends to matches[i] the symbols with a name of a kind in
+    // queries[i].nameType that matches queries[i]; a symbol appears once
+    // per matching name. Returns false if any regular expression is
+    // invalid; such queries match nothing.
+    bool match(std::vector<Symtab::SymbolQuery> const& queries,
+               std::vector<std::vector<Symbol *> > &matches) const;
+
+    size_t numNames() const { return names_.size(); }
+
+  private:
+    struct posting {
+        Symbol *sym;
+        unsigned nameTypes;  // NameType bits under which sym has this name
+    };
+
+    // Sorted, unique names; postings_[posting_start_[i], posting_start_[i+1])
+    // are the symbols of names_[i]
+    std::vector<std::string> names_;
+    std::vector<uint32_t> posting_start_;
+    std::vector<posting> postings_;
+
+    // Case-folded trigram -> ascending ids of the names containing it
+    std::unordered_map<uint32_t, std::vector<uint32_t> > trigrams_;
+
+    struct plan;
+    void makePlan(Symtab::SymbolQuery const& q, plan &p) const;
+    void collect(uint32_t name, unsigned nameTypes, std::vector<Symbol *> &out) const;
+};
+
+}
+}
+
+#endif
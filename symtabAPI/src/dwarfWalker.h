@@ -250,6 +250,11 @@ public:
 
     bool parse();
 
+    // The split halves of parse(): list every unit's DIE, .debug_types
+    // first, then parse a set of them (in parallel when possible).
+    std::vector<Dwarf_Die> findModuleDIEs();
+    bool parseModules(std::vector<Dwarf_Die> const& module_dies);
+
     // Takes current debug state as represented by dbg_;
     bool parseModule(Dwarf_Die is_info, Module *&fixUnknownMod);
 
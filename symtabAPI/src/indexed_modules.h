@@ -81,6 +81,8 @@ namespace Dyninst { namespace SymtabAPI {
 
     bool empty() const { return index.empty(); }
 
+    size_t size() const { return index.size(); }
+
     decltype(index)::iterator begin() { return index.begin(); }
 
     decltype(index)::iterator end() { return index.end(); }
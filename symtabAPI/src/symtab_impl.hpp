@@ -8,10 +8,14 @@
 #include "indexed_symbols.hpp"
 #include "indexed_modules.h"
 #include "MappedFile.h"
+#include "SymbolNameIndex.h"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <set>
+#include <vector>
 
 namespace Dyninst { namespace SymtabAPI {
 
@@ -24,6 +28,12 @@ namespace Dyninst { namespace SymtabAPI {
     std::once_flag funcRangesAreParsed{};
     std::once_flag types_parsed{};
 
+    // Lazy type parsing: one flag per module, created on first use
+    bool lazy_types{};
+    std::atomic<bool> types_started{};
+    dyn_c_hash_map<Module *, std::shared_ptr<std::once_flag>> module_types_parsed{};
+    std::atomic<size_t> module_types_done{};
+
     // Since Functions are unique by address, we require this structure to
     // efficiently track them.
     dyn_c_hash_map<Offset, Function *> funcsByOffset{};
@@ -41,6 +51,50 @@ namespace Dyninst { namespace SymtabAPI {
 
     MappedFile *mf{};
 
+    // Lazy symbol loading: one slot per SymbolIndex entry, filled in as
+    // lookups materialize the entry's Symbol. Guarded by index_mutex.
+    bool lazy_symbols{};
+    bool persistent_symbol_index{};
+    std::vector<Symbol *> indexed_syms{};
+    std::atomic<bool> all_indexed_syms{};
+    std::mutex index_mutex{};
+
+    // Indexed symbols by each demangled name that differs from their own,
+    // sorted by name. Built on the first pretty or typed name lookup;
+    // also guarded by index_mutex.
+    std::vector<std::pair<std::string, uint32_t>> demangled_syms{};
+    bool demangled_syms_built{};
+
+    // Name index for wildcard and regex lookups of defined symbols. Built
+    // on first use and dropped whenever everyDefinedSymbol changes.
+    std::shared_ptr<const SymbolNameIndex> name_index{};
+    std::mutex name_index_mutex{};
+
+    // Set under name_index_mutex before an index is built and cleared when
+    // it is dropped, so adding symbols takes the lock only if there is (or
+    // is about to be) an index to drop
+    std::atomic<bool> has_name_index{};
+
+    std::shared_ptr<const SymbolNameIndex> getNameIndex() {
+      std::lock_guard<std::mutex> l(name_index_mutex);
+      if(!name_index) {
+        has_name_index = true;
+        std::vector<Symbol *> syms(everyDefinedSymbol.begin(), everyDefinedSymbol.end());
+        name_index = std::make_shared<SymbolNameIndex>(syms);
+      }
+      return name_index;
+    }
+
+    // A symbol added before the flag is set is seen by the copy in
+    // getNameIndex; one added after waits here for the build and drops it
+    void dropNameIndex() {
+      if(!has_name_index)
+        return;
+      std::lock_guard<std::mutex> l(name_index_mutex);
+      name_index.reset();
+      has_name_index = false;
+    }
+
     Module* getContainingModule(Offset offset) const {
       std::set<ModRange*> mods;
       mod_lookup_.find(offset, mods);
@@ -0,0 +1,86 @@
+#ifndef DYNINST_TESTS_BENCHMARKS_DYNINSTAPI_MUTATEE_LAUNCHER_H
+#define DYNINST_TESTS_BENCHMARKS_DYNINSTAPI_MUTATEE_LAUNCHER_H
+
+#include "BPatch.h"
+#include "BPatch_process.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+/*
+ *  Shared launcher for benchmarks that run a copy of themselves as the
+ *  mutatee. The benchmark is started as `<exe> child <args...>` once per
+ *  mode, instrumented by that mode, and timed until the mutatee exits or
+ *  first stops on its own.
+ */
+
+namespace bench {
+  using clock_type = std::chrono::steady_clock;
+
+  struct mode {
+    char const* name;
+
+    // Instruments the newly created mutatee; empty for an uninstrumented run
+    std::function<bool(BPatch_process*)> instrument;
+
+    // Called if the mutatee stops on its own, e.g. at a breakpoint snippet,
+    // before it is continued to exit. Returns false if the run is wrong.
+    std::function<bool(BPatch_process*)> at_stop;
+  };
+
+  // True if this process is the mutatee, started with `nargs` arguments
+  inline bool is_child(int argc, char** argv, int nargs) {
+    return argc > nargs + 1 && !std::strcmp(argv[1], "child");
+  }
+
+  // Runs the mutatee under `m`. `run_ms` is the time from continuing it
+  // until it exits or stops.
+  inline bool run(BPatch& bpatch, char const* exe, std::vector<std::string> const& args,
+                  mode const& m, double& run_ms) {
+    std::vector<char const*> argv{exe, "child"};
+    for(auto const& a : args)
+      argv.push_back(a.c_str());
+    argv.push_back(nullptr);
+
+    BPatch_process* proc = bpatch.processCreate(exe, argv.data());
+    if(!proc) {
+      std::fprintf(stderr, "Unable to launch '%s'\n", exe);
+      return false;
+    }
+    if(m.instrument && !m.instrument(proc)) {
+      std::fprintf(stderr, "Unable to instrument the mutatee (%s)\n", m.name);
+      proc->terminateExecution();
+      return false;
+    }
+
+    auto const start = clock_type::now();
+    proc->continueExecution();
+    while(!proc->isTerminated() && !proc->isStopped())
+      bpatch.waitForStatusChange();
+    run_ms = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+
+    bool ok = true;
+    if(!proc->isTerminated()) {
+      if(m.at_stop && !m.at_stop(proc))
+        ok = false;
+      proc->continueExecution();
+    } else if(m.at_stop) {
+      std::fprintf(stderr, "Mutatee exited without stopping (%s)\n", m.name);
+      ok = false;
+    }
+    while(!proc->isTerminated())
+      bpatch.waitForStatusChange();
+
+    ok = ok && proc->terminationStatus() == ExitedNormally && proc->getExitCode() == EXIT_SUCCESS;
+    if(!ok)
+      std::fprintf(stderr, "Mutatee did not exit cleanly (%s)\n", m.name);
+    return ok;
+  }
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "BPatch.h"
+#include "BPatch_function.h"
+#include "BPatch_image.h"
+#include "BPatch_point.h"
+#include "BPatch_process.h"
+#include "BPatch_snippet.h"
+#include "mutatee-launcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/*
+ *  Compares relocating instrumented functions with patching a jump over
+ *  only the instrumented instructions.
+ *
+ *  Usage: point_patching_bench [calls]
+ *
+ *  A copy of this benchmark is launched as the mutatee, which calls
+ *  probe_target `calls` times. It is run uninstrumented, then with an
+ *  entry counter in probe_target inserted by relocation, then by point
+ *  patching. Reported are the time to insert the counter and the time
+ *  the mutatee takes to run to completion. The difference between the
+ *  two instrumented runs is the cost of executing relocated code over
+ *  the original.
+ */
+
+extern "C" __attribute__((noinline, used)) int probe_target(int x) {
+  int y = x;
+  for(int i = 0; i < 8; ++i)
+    y = y * 3 + i;
+  return y;
+}
+
+namespace {
+  int child(long calls) {
+    volatile int sink = 0;
+    for(long i = 0; i < calls; ++i)
+      sink = probe_target(static_cast<int>(i));
+    (void)sink;
+    return EXIT_SUCCESS;
+  }
+
+  // Inserts an entry counter in probe_target, timing only the insertion
+  bool instrument(BPatch_process* proc, bool patch, double& insert_ms) {
+    proc->allowPointPatching(patch);
+    BPatch_image* image = proc->getImage();
+    BPatch_Vector<BPatch_function*> targets;
+    image->findFunction("probe_target", targets);
+    BPatch_Vector<BPatch_point*>* entry = targets.empty() ? nullptr : targets[0]->findPoint(BPatch_entry);
+    BPatch_type* int_type = image->findType("int");
+    BPatch_variableExpr* counter = int_type ? proc->malloc(*int_type) : nullptr;
+    if(!entry || entry->empty() || !counter)
+      return false;
+    BPatch_arithExpr incr(BPatch_assign, *counter,
+                          BPatch_arithExpr(BPatch_plus, *counter, BPatch_constExpr(1)));
+
+    auto const start = bench::clock_type::now();
+    bool const ok = proc->insertSnippet(incr, *entry) != nullptr;
+    insert_ms = std::chrono::duration<double, std::milli>(bench::clock_type::now() - start).count();
+    return ok;
+  }
+}
+
+int main(int argc, char** argv) {
+  if(bench::is_child(argc, argv, 1))
+    return child(std::strtol(argv[2], nullptr, 10));
+
+  long const calls = (argc > 1) ? std::max(std::strtol(argv[1], nullptr, 10), 1L) : 10000000;
+
+  double insert_ms = 0;
+  bench::mode const modes[] = {
+      {"none", nullptr, nullptr},
+      {"relocate", [&](BPatch_process* p) { return instrument(p, false, insert_ms); }, nullptr},
+      {"patch", [&](BPatch_process* p) { return instrument(p, true, insert_ms); }, nullptr},
+  };
+
+  BPatch bpatch;
+  std::printf("%ld calls\n", calls);
+  std::printf("%-10s %12s %12s %12s\n", "mode", "insert ms", "run ms", "ns/call");
+  for(auto const& m : modes) {
+    insert_ms = 0;
+    double run_ms = 0;
+    if(!bench::run(bpatch, argv[0], {std::to_string(calls)}, m, run_ms))
+      return EXIT_FAILURE;
+    std::printf("%-10s %12.2f %12.2f %12.2f\n", m.name, insert_ms, run_ms, run_ms * 1e6 / calls);
+  }
+  return EXIT_SUCCESS;
+}
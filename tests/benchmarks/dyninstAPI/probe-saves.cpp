@@ -0,0 +1,105 @@
+#include "BPatch.h"
+#include "BPatch_function.h"
+#include "BPatch_image.h"
+#include "BPatch_point.h"
+#include "BPatch_process.h"
+#include "BPatch_snippet.h"
+#include "mutatee-launcher.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/*
+ *  Measures the overhead of counting probes that call into the mutatee,
+ *  by how much register state the base tramp has to save around them.
+ *
+ *  Usage: probe_saves_bench [calls]
+ *
+ *  A copy of this benchmark is launched as the mutatee, which calls
+ *  probe_target `calls` times with a floating-point argument live in
+ *  xmm0. It is run uninstrumented, with an inline counter at the entry
+ *  of probe_target, with a call to the runtime library's
+ *  DYNINSTreturnZero, whose register writes are summarized, and with a
+ *  call to count_hit in the mutatee, which is assumed to clobber
+ *  everything a call may. The last is what every call cost before
+ *  register summaries.
+ */
+
+extern "C" {
+  volatile long hits = 0;
+
+  __attribute__((noinline, used)) void count_hit() { ++hits; }
+
+  __attribute__((noinline, used)) double probe_target(double x) { return x * 0.5 + 1.0; }
+}
+
+namespace {
+  int child(long calls) {
+    volatile double sink = 0;
+    for(long i = 0; i < calls; ++i)
+      sink = probe_target(static_cast<double>(i));
+    (void)sink;
+    return EXIT_SUCCESS;
+  }
+
+  BPatch_function* find(BPatch_image* image, char const* fname) {
+    BPatch_Vector<BPatch_function*> funcs;
+    image->findFunction(fname, funcs);
+    return funcs.empty() ? nullptr : funcs[0];
+  }
+
+  BPatch_Vector<BPatch_point*>* target_entry(BPatch_image* image) {
+    BPatch_function* target = find(image, "probe_target");
+    BPatch_Vector<BPatch_point*>* entry = target ? target->findPoint(BPatch_entry) : nullptr;
+    return (entry && !entry->empty()) ? entry : nullptr;
+  }
+
+  bool count_inline(BPatch_process* proc) {
+    BPatch_image* image = proc->getImage();
+    BPatch_Vector<BPatch_point*>* entry = target_entry(image);
+    BPatch_variableExpr* counter = image->findVariable("hits");
+    if(!entry || !counter)
+      return false;
+    BPatch_arithExpr incr(BPatch_assign, *counter,
+                          BPatch_arithExpr(BPatch_plus, *counter, BPatch_constExpr(1)));
+    return proc->insertSnippet(incr, *entry) != nullptr;
+  }
+
+  bool call(BPatch_process* proc, char const* fname) {
+    BPatch_image* image = proc->getImage();
+    BPatch_Vector<BPatch_point*>* entry = target_entry(image);
+    BPatch_function* callee = find(image, fname);
+    if(!entry || !callee)
+      return false;
+    BPatch_Vector<BPatch_snippet*> args;
+    BPatch_funcCallExpr call_expr(*callee, args);
+    return proc->insertSnippet(call_expr, *entry) != nullptr;
+  }
+}
+
+int main(int argc, char** argv) {
+  if(bench::is_child(argc, argv, 1))
+    return child(std::strtol(argv[2], nullptr, 10));
+
+  long const calls = (argc > 1) ? std::max(std::strtol(argv[1], nullptr, 10), 1L) : 10000000;
+
+  bench::mode const modes[] = {
+      {"none", nullptr, nullptr},
+      {"inline", count_inline, nullptr},
+      {"RT call", [](BPatch_process* p) { return call(p, "DYNINSTreturnZero"); }, nullptr},
+      {"call", [](BPatch_process* p) { return call(p, "count_hit"); }, nullptr},
+  };
+
+  BPatch bpatch;
+  std::printf("%ld calls\n", calls);
+  std::printf("%-12s %12s %12s\n", "probe", "run ms", "ns/call");
+  for(auto const& m : modes) {
+    double run_ms = 0;
+    if(!bench::run(bpatch, argv[0], {std::to_string(calls)}, m, run_ms))
+      return EXIT_FAILURE;
+    std::printf("%-12s %12.2f %12.2f\n", m.name, run_ms, run_ms * 1e6 / calls);
+  }
+  return EXIT_SUCCESS;
+}
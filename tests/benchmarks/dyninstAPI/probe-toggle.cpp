@@ -0,0 +1,112 @@
+#include "BPatch.h"
+#include "BPatch_function.h"
+#include "BPatch_image.h"
+#include "BPatch_point.h"
+#include "BPatch_process.h"
+#include "BPatch_snippet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/*
+ *  Measures the cost of toggling a probe on one function while a growing
+ *  number of other functions stay instrumented.
+ *
+ *  Usage: probe_toggle_bench [toggles] [background...]
+ *
+ *  A copy of this benchmark is launched as the mutatee. For each number of
+ *  background functions (0, 256 and 4096 by default, limited to what the
+ *  mutatee has), those functions get an entry counter first. Then a probe
+ *  on probe_target is inserted and removed `toggles` times, each of which
+ *  relocates the function again. Only the toggled function should be
+ *  regenerated, so the time per toggle should not grow with the
+ *  background count.
+ */
+
+extern "C" __attribute__((noinline, used)) int probe_target(int x) { return x + 1; }
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  BPatch_Vector<BPatch_point*>* entry_of(BPatch_function* f) {
+    BPatch_Vector<BPatch_point*>* points = f->findPoint(BPatch_entry);
+    return (points && !points->empty()) ? points : nullptr;
+  }
+}
+
+int main(int argc, char** argv) {
+  if(argc > 1 && !std::strcmp(argv[1], "child"))
+    return probe_target(0) == 1 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+  long const toggles = (argc > 1) ? std::max(std::strtol(argv[1], nullptr, 10), 1L) : 200;
+  std::vector<size_t> counts;
+  for(int i = 2; i < argc; ++i)
+    counts.push_back(std::strtoul(argv[i], nullptr, 10));
+  if(counts.empty())
+    counts = {0, 256, 4096};
+  std::sort(counts.begin(), counts.end());
+
+  BPatch bpatch;
+  char const* args[] = {argv[0], "child", nullptr};
+  BPatch_process* proc = bpatch.processCreate(argv[0], args);
+  if(!proc) {
+    std::fprintf(stderr, "Unable to launch '%s'\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  BPatch_image* image = proc->getImage();
+
+  BPatch_Vector<BPatch_function*> targets;
+  image->findFunction("probe_target", targets);
+  BPatch_type* int_type = image->findType("int");
+  BPatch_variableExpr* counter = int_type ? proc->malloc(*int_type) : nullptr;
+  BPatch_Vector<BPatch_point*>* target_entry = targets.empty() ? nullptr : entry_of(targets[0]);
+  if(!target_entry || !counter) {
+    std::fprintf(stderr, "Unable to find probe_target in the mutatee\n");
+    proc->terminateExecution();
+    return EXIT_FAILURE;
+  }
+  BPatch_arithExpr incr(BPatch_assign, *counter,
+                        BPatch_arithExpr(BPatch_plus, *counter, BPatch_constExpr(1)));
+
+  BPatch_Vector<BPatch_function*> funcs;
+  image->getProcedures(funcs);
+  funcs.erase(std::remove(funcs.begin(), funcs.end(), targets[0]), funcs.end());
+
+  int status = EXIT_SUCCESS;
+  size_t instrumented = 0;
+  auto next = funcs.begin();
+  std::printf("%ld toggles\n", toggles);
+  std::printf("%12s %12s\n", "background", "us/toggle");
+  for(size_t n : counts) {
+    proc->beginInsertionSet();
+    for(; instrumented < n && next != funcs.end(); ++next) {
+      BPatch_Vector<BPatch_point*>* entry = entry_of(*next);
+      if(entry && proc->insertSnippet(incr, *entry))
+        ++instrumented;
+    }
+    proc->finalizeInsertionSet(false);
+
+    auto const start = clock_type::now();
+    for(long i = 0; i < toggles; ++i) {
+      BPatchSnippetHandle* probe = proc->insertSnippet(incr, *target_entry);
+      if(!probe || !proc->deleteSnippet(probe)) {
+        std::fprintf(stderr, "Unable to toggle the probe with %zu background functions\n", instrumented);
+        status = EXIT_FAILURE;
+        break;
+      }
+    }
+    double const us = std::chrono::duration<double, std::micro>(clock_type::now() - start).count();
+    if(status != EXIT_SUCCESS)
+      break;
+    std::printf("%12zu %12.1f\n", instrumented, us / toggles);
+    if(next == funcs.end())
+      break;
+  }
+
+  proc->terminateExecution();
+  return status;
+}
@@ -0,0 +1,102 @@
+#include "BPatch.h"
+#include "BPatch_binaryEdit.h"
+#include "BPatch_function.h"
+#include "BPatch_image.h"
+#include "BPatch_point.h"
+#include "BPatch_snippet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ *  Measures how relocation of an instrumented binary scales with
+ *  BPatch::setRelocationThreads.
+ *
+ *  Usage: relocation_threads_bench [-j max_threads] [binary]
+ *
+ *  The binary (default: this executable) is opened for rewriting, a
+ *  counter increment is inserted at the entry of every function, and the
+ *  result is written out with 1, 2, 4, ... up to max_threads threads
+ *  (default: the number of hardware threads). Times are for writeFile,
+ *  which relocates every instrumented function.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  bool rewrite(BPatch& bpatch, std::string const& file, std::string const& out, unsigned threads,
+               double& ms, size_t& nfuncs) {
+    bpatch.setRelocationThreads(threads);
+    BPatch_binaryEdit* edit = bpatch.openBinary(file.c_str());
+    if(!edit) {
+      std::fprintf(stderr, "Unable to open '%s'\n", file.c_str());
+      return false;
+    }
+    BPatch_image* image = edit->getImage();
+    BPatch_type* int_type = image->findType("int");
+    BPatch_variableExpr* counter = int_type ? edit->malloc(*int_type) : nullptr;
+    if(!counter) {
+      std::fprintf(stderr, "Unable to allocate a counter in '%s'\n", file.c_str());
+      return false;
+    }
+    BPatch_arithExpr incr(BPatch_assign, *counter,
+                          BPatch_arithExpr(BPatch_plus, *counter, BPatch_constExpr(1)));
+
+    BPatch_Vector<BPatch_function*> funcs;
+    image->getProcedures(funcs);
+    nfuncs = 0;
+    edit->beginInsertionSet();
+    for(auto* f : funcs) {
+      BPatch_Vector<BPatch_point*>* entry = f->findPoint(BPatch_entry);
+      if(entry && !entry->empty() && edit->insertSnippet(incr, *entry))
+        ++nfuncs;
+    }
+
+    auto const start = clock_type::now();
+    bool const ok = edit->writeFile(out.c_str());
+    ms = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    std::remove(out.c_str());
+    if(!ok)
+      std::fprintf(stderr, "Unable to write '%s' with %u threads\n", out.c_str(), threads);
+    return ok;
+  }
+}
+
+int main(int argc, char** argv) {
+  unsigned max_threads = std::max(1U, std::thread::hardware_concurrency());
+  std::string file = argv[0];
+  for(int i = 1; i < argc; ++i) {
+    if(!std::strcmp(argv[i], "-j") && i + 1 < argc) {
+      max_threads = std::max(1, std::atoi(argv[++i]));
+    } else {
+      file = argv[i];
+    }
+  }
+  std::string const out = file.substr(file.find_last_of('/') + 1) + ".reloc";
+
+  std::vector<unsigned> counts;
+  for(unsigned n = 1; n < max_threads; n *= 2)
+    counts.push_back(n);
+  counts.push_back(max_threads);
+
+  BPatch bpatch;
+  double base_ms = 0;
+  std::printf("%s\n", file.c_str());
+  std::printf("%8s %10s %12s %8s\n", "threads", "functions", "write ms", "speedup");
+  for(unsigned n : counts) {
+    double ms = 0;
+    size_t nfuncs = 0;
+    if(!rewrite(bpatch, file, out, n, ms, nfuncs))
+      return EXIT_FAILURE;
+    if(n == 1)
+      base_ms = ms;
+    std::printf("%8u %10zu %12.2f %8.2f\n", n, nfuncs, ms, ms > 0 ? base_ms / ms : 0.0);
+  }
+  return EXIT_SUCCESS;
+}
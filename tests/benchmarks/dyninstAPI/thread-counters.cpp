@@ -0,0 +1,126 @@
+#include "BPatch.h"
+#include "BPatch_function.h"
+#include "BPatch_image.h"
+#include "BPatch_point.h"
+#include "BPatch_process.h"
+#include "BPatch_snippet.h"
+#include "mutatee-launcher.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ *  Compares a counter shared by every thread with per-thread counters.
+ *
+ *  Usage: thread_counters_bench [threads] [calls] [rounds]
+ *
+ *  A copy of this benchmark is launched as the mutatee, which calls
+ *  probe_target `calls` times on each of `threads` threads, and starts
+ *  a new set of threads `rounds` times. More threads are started over
+ *  the run than there are counter slabs, so slabs have to be reused. It
+ *  is run
+ *  uninstrumented, with an entry counter in probe_target held in one
+ *  shared variable, and with a per-thread counter. The mutatee stops
+ *  in counting_done once its threads have joined, where the per-thread
+ *  counter is summed and checked against the number of calls made.
+ */
+
+extern "C" {
+  __attribute__((noinline, used)) int probe_target(int x) { return x * 3 + 1; }
+
+  __attribute__((noinline, used)) void counting_done() {}
+}
+
+namespace {
+  int child(int nthreads, long calls, int rounds) {
+    for(int r = 0; r < rounds; ++r) {
+      std::vector<std::thread> threads;
+      for(int t = 0; t < nthreads; ++t)
+        threads.emplace_back([calls] {
+          volatile int sink = 0;
+          for(long i = 0; i < calls; ++i)
+            sink = probe_target(static_cast<int>(i));
+          (void)sink;
+        });
+      for(auto& t : threads)
+        t.join();
+    }
+    counting_done();
+    return EXIT_SUCCESS;
+  }
+
+  BPatch_Vector<BPatch_point*>* entry_of(BPatch_image* image, char const* fname) {
+    BPatch_Vector<BPatch_function*> funcs;
+    image->findFunction(fname, funcs);
+    BPatch_Vector<BPatch_point*>* entry = funcs.empty() ? nullptr : funcs[0]->findPoint(BPatch_entry);
+    return (entry && !entry->empty()) ? entry : nullptr;
+  }
+
+  bool count_shared(BPatch_process* proc) {
+    BPatch_image* image = proc->getImage();
+    BPatch_Vector<BPatch_point*>* entry = entry_of(image, "probe_target");
+    BPatch_type* long_type = image->findType("long");
+    BPatch_variableExpr* shared = long_type ? proc->malloc(*long_type) : nullptr;
+    if(!entry || !shared)
+      return false;
+    BPatch_arithExpr incr(BPatch_assign, *shared,
+                          BPatch_arithExpr(BPatch_plus, *shared, BPatch_constExpr(1)));
+    return proc->insertSnippet(incr, *entry) != nullptr;
+  }
+
+  // Counts per thread and stops in counting_done so the total can be read
+  bool count_per_thread(BPatch_process* proc, int& counter) {
+    BPatch_image* image = proc->getImage();
+    BPatch_Vector<BPatch_point*>* entry = entry_of(image, "probe_target");
+    BPatch_Vector<BPatch_point*>* done = entry_of(image, "counting_done");
+    if(!entry || !done)
+      return false;
+    counter = proc->createThreadCounter();
+    if(counter < 0)
+      return false;
+    BPatch_threadCounterExpr incr(proc, counter);
+    BPatch_breakPointExpr stop;
+    return proc->insertSnippet(incr, *entry) && proc->insertSnippet(stop, *done);
+  }
+}
+
+int main(int argc, char** argv) {
+  if(bench::is_child(argc, argv, 3))
+    return child(std::atoi(argv[2]), std::strtol(argv[3], nullptr, 10), std::atoi(argv[4]));
+
+  int const nthreads = (argc > 1) ? std::max(std::atoi(argv[1]), 1) : 8;
+  long const calls = (argc > 2) ? std::max(std::strtol(argv[2], nullptr, 10), 1L) : 50000;
+  int const rounds = (argc > 3) ? std::max(std::atoi(argv[3]), 1) : 40;
+  long long const expected = static_cast<long long>(nthreads) * calls * rounds;
+
+  int counter = -1;
+  auto check = [&](BPatch_process* p) {
+    long long sum = 0;
+    if(!p->readThreadCounter(counter, sum) || sum != expected) {
+      std::fprintf(stderr, "Counted %lld of %lld calls\n", sum, expected);
+      return false;
+    }
+    return true;
+  };
+  bench::mode const modes[] = {
+      {"none", nullptr, nullptr},
+      {"shared", count_shared, nullptr},
+      {"per-thread", [&](BPatch_process* p) { return count_per_thread(p, counter); }, check},
+  };
+
+  BPatch bpatch;
+  std::vector<std::string> const args{std::to_string(nthreads), std::to_string(calls), std::to_string(rounds)};
+  std::printf("%d threads, %ld calls each, %d rounds\n", nthreads, calls, rounds);
+  std::printf("%-12s %12s %12s\n", "counter", "run ms", "ns/call");
+  for(auto const& m : modes) {
+    double run_ms = 0;
+    if(!bench::run(bpatch, argv[0], args, m, run_ms))
+      return EXIT_FAILURE;
+    std::printf("%-12s %12.2f %12.2f\n", m.name, run_ms, run_ms * 1e6 / expected);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+#include "dyninstAPI_RT.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <vector>
+
+/*
+ *  Measures trap-based control transfers through the runtime library's
+ *  SIGTRAP handler.
+ *
+ *  Usage: trap_translate_bench [seconds] [traps...]
+ *
+ *  For each table size (64, 1024 and 16384 by default), that many stubs of
+ *  `int3; ret` are generated and the trap table maps each trap back to its
+ *  `ret`. The table is published in the unsorted, sorted and hashed layouts
+ *  in turn, exactly as the mutator does, and the stubs are called round
+ *  robin. Reported is the number of trap-based transfers per second.
+ */
+
+extern "C" {
+  extern int DYNINSTstaticMode;
+  extern volatile unsigned long dyninstTrapTableUsed;
+  extern volatile unsigned long dyninstTrapTableVersion;
+  extern volatile trapMapping_t* dyninstTrapTable;
+  extern volatile unsigned long dyninstTrapTableIsSorted;
+}
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  constexpr size_t stub_size = 16;
+
+  struct stubs {
+    unsigned char* code{};
+    size_t length{};
+
+    explicit stubs(size_t count) : length(count * stub_size) {
+      void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if(p == MAP_FAILED) {
+        length = 0;
+        return;
+      }
+      code = static_cast<unsigned char*>(p);
+      for(size_t i = 0; i < count; ++i) {
+        code[i * stub_size] = 0xcc;     // int3
+        code[i * stub_size + 1] = 0xc3; // ret
+      }
+    }
+    ~stubs() {
+      if(code) munmap(code, length);
+    }
+    stubs(stubs const&) = delete;
+    stubs& operator=(stubs const&) = delete;
+
+    // x86 reports the trap one byte past the int3
+    void* source(size_t i) const { return code + i * stub_size + 1; }
+  };
+
+  std::vector<trapMapping_t> layout(stubs const& s, size_t count, unsigned long mode, unsigned long& used) {
+    std::vector<trapMapping_t> table;
+    if(mode == TRAP_TABLE_HASHED) {
+      used = 1;
+      while(used < count * 2)
+        used *= 2;
+      table.assign(used, trapMapping_t{nullptr, nullptr});
+      for(size_t i = 0; i < count; ++i) {
+        unsigned long slot = DYNINSTtrapHash(reinterpret_cast<uintptr_t>(s.source(i)), used - 1);
+        while(table[slot].source)
+          slot = (slot + 1) & (used - 1);
+        table[slot] = trapMapping_t{s.source(i), s.source(i)};
+      }
+      return table;
+    }
+    for(size_t i = 0; i < count; ++i)
+      table.push_back(trapMapping_t{s.source(i), s.source(i)});
+    if(mode == TRAP_TABLE_SORTED) {
+      std::sort(table.begin(), table.end(),
+                [](trapMapping_t const& a, trapMapping_t const& b) { return a.source < b.source; });
+    } else {
+      // Put the entries in the order the mutator happened to add them
+      std::reverse(table.begin(), table.end());
+    }
+    used = table.size();
+    return table;
+  }
+
+  void publish(std::vector<trapMapping_t>& table, unsigned long used, unsigned long mode) {
+    dyninstTrapTableUsed = used;
+    dyninstTrapTable = table.data();
+    dyninstTrapTableIsSorted = mode;
+    ++dyninstTrapTableVersion;
+  }
+
+  double run(stubs const& s, size_t count, double seconds) {
+    using stub_fn = void (*)();
+    unsigned long transfers = 0;
+    auto start = clock_type::now();
+    auto const stop = start + std::chrono::duration<double>(seconds);
+    do {
+      for(size_t i = 0; i < count; ++i)
+        reinterpret_cast<stub_fn>(s.code + i * stub_size)();
+      transfers += count;
+    } while(clock_type::now() < stop);
+    double const secs = std::chrono::duration<double>(clock_type::now() - start).count();
+    return transfers / secs;
+  }
+
+  char const* name(unsigned long mode) {
+    switch(mode) {
+      case TRAP_TABLE_UNSORTED: return "unsorted";
+      case TRAP_TABLE_SORTED: return "sorted";
+      default: return "hashed";
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  double const seconds = (argc > 1) ? std::max(std::atof(argv[1]), 0.01) : 0.5;
+  std::vector<size_t> counts;
+  for(int i = 2; i < argc; ++i)
+    counts.push_back(std::strtoul(argv[i], nullptr, 10));
+  if(counts.empty())
+    counts = {64, 1024, 16384};
+
+  // Use the live-process trap table rather than a rewritten binary's
+  DYNINSTstaticMode = 0;
+
+  std::printf("%8s %-10s %14s\n", "traps", "layout", "transfers/sec");
+  for(size_t n : counts) {
+    if(!n) continue;
+    stubs s(n);
+    if(!s.code) {
+      std::fprintf(stderr, "Unable to map %zu stubs\n", n);
+      return EXIT_FAILURE;
+    }
+    for(unsigned long mode : {TRAP_TABLE_UNSORTED, TRAP_TABLE_SORTED, TRAP_TABLE_HASHED}) {
+      unsigned long used = 0;
+      std::vector<trapMapping_t> table = layout(s, n, mode, used);
+      publish(table, used, mode);
+      std::printf("%8zu %-10s %14.0f\n", n, name(mode), run(s, n, seconds));
+      publish(table, 0, TRAP_TABLE_UNSORTED);
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+#include "InstructionBatch.h"
+#include "InstructionDecoder.h"
+#include "Region.h"
+#include "Symtab.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace di = Dyninst::InstructionAPI;
+namespace st = Dyninst::SymtabAPI;
+
+/*
+ *  Compares one-at-a-time instruction decoding with batch decoding.
+ *
+ *  Usage: decode_throughput_bench [binary]
+ *
+ *  The .text section of the binary (default: this executable) is decoded
+ *  three ways: decode() alone, decode() followed by building the operands
+ *  as the parser and slicer do, and decodeBatch() into compact records.
+ *  Bytes that don't decode are skipped one at a time in every mode.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  struct result {
+    double ms{};
+    size_t insns{};
+  };
+
+  template <typename F>
+  result sweep(const unsigned char* buf, size_t size, Dyninst::Architecture arch, F&& decode_from) {
+    result r;
+    auto const start = clock_type::now();
+    size_t pos = 0;
+    while(pos < size) {
+      di::InstructionDecoder dec(buf + pos, size - pos, arch);
+      auto const used = decode_from(dec, r.insns);
+      pos += used ? used : 1;
+    }
+    r.ms = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    return r;
+  }
+
+  // Each returns the number of bytes consumed before the first illegal instruction
+  size_t single(di::InstructionDecoder& dec, size_t& count, bool operands) {
+    size_t used = 0;
+    for(auto insn = dec.decode(); insn.isLegalInsn() && insn.size(); insn = dec.decode()) {
+      if(operands) insn.getAllOperands();
+      used += insn.size();
+      count++;
+    }
+    return used;
+  }
+
+  size_t batched(di::InstructionDecoder& dec, di::InstructionBatch& batch, size_t& count) {
+    size_t used = 0;
+    while(dec.decodeBatch(batch, 4096)) {
+      used += batch.bytes();
+      count += batch.size();
+    }
+    return used;
+  }
+
+  void print(char const* mode, result const& r, size_t bytes) {
+    std::printf("%-16s %10.2f %12zu %10.2f %10.2f\n", mode, r.ms, r.insns,
+                (bytes / 1048576.0) / (r.ms / 1000.0), (r.insns / 1e6) / (r.ms / 1000.0));
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string const file = (argc > 1) ? argv[1] : argv[0];
+
+  st::Symtab* obj{};
+  if(!st::Symtab::openFile(obj, file)) {
+    std::fprintf(stderr, "Unable to open '%s'\n", file.c_str());
+    return EXIT_FAILURE;
+  }
+  st::Region* text{};
+  if(!obj->findRegion(text, ".text") || !text->getPtrToRawData()) {
+    std::fprintf(stderr, "No .text in '%s'\n", file.c_str());
+    st::Symtab::closeSymtab(obj);
+    return EXIT_FAILURE;
+  }
+  auto const* buf = static_cast<const unsigned char*>(text->getPtrToRawData());
+  auto const size = static_cast<size_t>(text->getDiskSize());
+  auto const arch = obj->getArchitecture();
+
+  auto const plain = sweep(buf, size, arch, [](di::InstructionDecoder& d, size_t& n) {
+    return single(d, n, false);
+  });
+  auto const full = sweep(buf, size, arch, [](di::InstructionDecoder& d, size_t& n) {
+    return single(d, n, true);
+  });
+  di::InstructionBatch batch;
+  auto const compact = sweep(buf, size, arch, [&batch](di::InstructionDecoder& d, size_t& n) {
+    return batched(d, batch, n);
+  });
+
+  std::printf("%s: %zu bytes of .text\n", file.c_str(), size);
+  std::printf("record size: Instruction %zu bytes, CompactInstruction %zu bytes\n",
+              sizeof(di::Instruction), sizeof(di::CompactInstruction));
+  std::printf("%-16s %10s %12s %10s %10s\n", "mode", "time (ms)", "insns", "MB/s", "Minsn/s");
+  print("decode", plain, size);
+  print("decode+operands", full, size);
+  print("batch", compact, size);
+
+  st::Symtab::closeSymtab(obj);
+
+  if(plain.insns != compact.insns) {
+    std::fprintf(stderr, "Mismatch: decode found %zu instructions, batch %zu\n", plain.insns,
+                 compact.insns);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+#include "InstructionDecoder.h"
+#include "Region.h"
+#include "Symtab.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace di = Dyninst::InstructionAPI;
+namespace st = Dyninst::SymtabAPI;
+
+/*
+ *  Measures the heap traffic of building operand ASTs with and without
+ *  the expression arena.
+ *
+ *  Usage: expression_arena_bench [binary]
+ *
+ *  Every instruction in the .text section of the binary (default: this
+ *  executable) is decoded and its operands built, and the instructions are
+ *  kept alive as a parser's instruction cache would. Each mode runs in its
+ *  own process, as DYNINST_EXPR_ARENA is read once. Global operator new is
+ *  replaced to count heap allocations during decoding and the heap still
+ *  in use afterwards.
+ */
+
+namespace {
+  std::atomic<size_t> num_allocs{0};
+  std::atomic<size_t> live_bytes{0};
+
+  void* counted_alloc(std::size_t n) {
+    void* p = std::malloc(n ? n : 1);
+    if(!p) throw std::bad_alloc{};
+    num_allocs.fetch_add(1, std::memory_order_relaxed);
+    live_bytes.fetch_add(malloc_usable_size(p), std::memory_order_relaxed);
+    return p;
+  }
+
+  void counted_free(void* p) noexcept {
+    if(!p) return;
+    live_bytes.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+    std::free(p);
+  }
+}
+
+void* operator new(std::size_t n) { return counted_alloc(n); }
+void* operator new[](std::size_t n) { return counted_alloc(n); }
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  struct result {
+    bool ok{};
+    double ms{};
+    size_t insns{}, operands{}, allocs{}, live{};
+  };
+
+  result run(std::string const& file) {
+    result r;
+    st::Symtab* obj{};
+    st::Region* text{};
+    if(!st::Symtab::openFile(obj, file) || !obj->findRegion(text, ".text") ||
+       !text->getPtrToRawData()) {
+      std::fprintf(stderr, "Unable to read .text of '%s'\n", file.c_str());
+      return r;
+    }
+    auto const* buf = static_cast<const unsigned char*>(text->getPtrToRawData());
+    auto const size = static_cast<size_t>(text->getDiskSize());
+
+    std::vector<di::Instruction> cache;
+    cache.reserve(size / 3);
+
+    auto const allocs_before = num_allocs.load();
+    auto const live_before = live_bytes.load();
+    auto const start = clock_type::now();
+
+    size_t pos = 0;
+    while(pos < size) {
+      di::InstructionDecoder dec(buf + pos, size - pos, obj->getArchitecture());
+      auto insn = dec.decode();
+      if(!insn.isLegalInsn() || !insn.size()) {
+        pos++;
+        continue;
+      }
+      pos += insn.size();
+      r.operands += insn.getAllOperands().size();
+      cache.push_back(std::move(insn));
+    }
+
+    r.ms = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    r.allocs = num_allocs.load() - allocs_before;
+    r.live = live_bytes.load() - live_before;
+    r.insns = cache.size();
+    r.ok = true;
+    return r;
+  }
+
+  // Runs one mode in a child process and collects its result through a pipe
+  bool run_mode(std::string const& file, char const* arena, result& r) {
+    int fds[2];
+    if(pipe(fds) != 0) return false;
+    pid_t const pid = fork();
+    if(pid < 0) return false;
+    if(pid == 0) {
+      close(fds[0]);
+      setenv("DYNINST_EXPR_ARENA", arena, 1);
+      auto const res = run(file);
+      auto const n = write(fds[1], &res, sizeof res);
+      _exit(n == sizeof res && res.ok ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    close(fds[1]);
+    auto const n = read(fds[0], &r, sizeof r);
+    close(fds[0]);
+    int status{};
+    waitpid(pid, &status, 0);
+    return n == sizeof r && WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+  }
+
+  void print(char const* mode, result const& r) {
+    std::printf("%-6s %10.2f %10zu %10zu %12zu %10.2f %10.2f\n", mode, r.ms, r.insns, r.operands,
+                r.allocs, static_cast<double>(r.allocs) / r.insns, r.live / 1048576.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string const file = (argc > 1) ? argv[1] : argv[0];
+
+  result heap, arena;
+  if(!run_mode(file, "0", heap) || !run_mode(file, "1", arena)) return EXIT_FAILURE;
+
+  std::printf("%s\n", file.c_str());
+  std::printf("%-6s %10s %10s %10s %12s %10s %10s\n", "mode", "time (ms)", "insns", "operands",
+              "allocations", "per insn", "live (MB)");
+  print("heap", heap);
+  print("arena", arena);
+
+  if(heap.insns != arena.insns || heap.operands != arena.operands) {
+    std::fprintf(stderr, "Mismatch: heap decoded %zu instructions and %zu operands, arena %zu and %zu\n",
+                 heap.insns, heap.operands, arena.insns, arena.operands);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+#include "CFG.h"
+#include "CodeObject.h"
+#include "CodeSource.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dp = Dyninst::ParseAPI;
+using Dyninst::Address;
+
+/*
+ *  Times function and block lookups by address before and after
+ *  CodeObject::freezeLookups() freezes the lookup tables.
+ *
+ *  Usage: block_lookup_bench [binary] [threads]
+ *
+ *  Every thread looks up the start and the middle of every block with
+ *  findBlockByEntry, findBlocks and findFuncs. The live tables take
+ *  concurrent hash map and interval tree locks; the frozen ones none.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  struct query {
+    dp::CodeRegion* region;
+    Address addr;
+  };
+
+  struct result {
+    double ms{};
+    size_t found{};
+  };
+
+  result run(dp::CodeObject& co, std::vector<query> const& queries, unsigned nthreads) {
+    std::atomic<size_t> found(0);
+    auto const start = clock_type::now();
+    std::vector<std::thread> threads;
+    for(unsigned t = 0; t < nthreads; ++t) {
+      threads.emplace_back([&]() {
+        size_t n = 0;
+        std::set<dp::Block*> blocks;
+        std::set<dp::Function*> funcs;
+        for(auto const& q : queries) {
+          blocks.clear();
+          funcs.clear();
+          n += co.findBlockByEntry(q.region, q.addr) != nullptr;
+          n += co.findBlocks(q.region, q.addr, blocks);
+          n += co.findFuncs(q.region, q.addr, funcs);
+        }
+        found += n;
+      });
+    }
+    for(auto& th : threads) th.join();
+    result r;
+    r.ms = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    r.found = found / nthreads;
+    return r;
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string const file = (argc > 1) ? argv[1] : argv[0];
+  unsigned nthreads = (argc > 2) ? std::strtoul(argv[2], nullptr, 10)
+                                 : std::thread::hardware_concurrency();
+  nthreads = std::max(nthreads, 1U);
+
+  auto* src = new dp::SymtabCodeSource(const_cast<char*>(file.c_str()));
+  auto* co = new dp::CodeObject(src, nullptr, nullptr, false, true);
+  co->parse();
+
+  std::vector<query> queries;
+  for(auto* f : co->funcs()) {
+    for(auto* b : f->blocks()) {
+      queries.push_back({b->region(), b->start()});
+      queries.push_back({b->region(), b->start() + b->size() / 2});
+    }
+  }
+  if(queries.empty()) {
+    std::fprintf(stderr, "No blocks parsed in '%s'\n", file.c_str());
+    return EXIT_FAILURE;
+  }
+
+  // Range queries finalize the parse but do not freeze it
+  std::set<dp::Function*> funcs;
+  co->findFuncs(queries.front().region, queries.front().addr, funcs);
+  result const live = run(*co, queries, nthreads);
+
+  auto const start = clock_type::now();
+  co->freezeLookups();
+  double const freeze_ms =
+      std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+  result const frozen = run(*co, queries, nthreads);
+
+  std::printf("%s: %zu queries, %u threads, freezing took %.2f ms\n", file.c_str(),
+              queries.size(), nthreads, freeze_ms);
+  std::printf("%-8s %10s %12s %10s\n", "tables", "ms", "ns/query", "found");
+  std::printf("%-8s %10.2f %12.1f %10zu\n", "live", live.ms, 1e6 * live.ms / queries.size(),
+              live.found);
+  std::printf("%-8s %10.2f %12.1f %10zu\n", "frozen", frozen.ms,
+              1e6 * frozen.ms / queries.size(), frozen.found);
+
+  delete co;
+  delete src;
+
+  if(live.found != frozen.found) {
+    std::fprintf(stderr, "Mismatch: live tables found %zu, frozen %zu\n", live.found,
+                 frozen.found);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#include "CodeObject.h"
+#include "CodeSource.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dp = Dyninst::ParseAPI;
+
+/*
+ *  Measures how parsing scales with the number of parser threads.
+ *
+ *  Usage: parse_scaling [-j max_threads] [binary...]
+ *
+ *  The corpus (default: this executable) is parsed with 1, 2, 4, ... up to
+ *  max_threads threads (default: the number of hardware threads) by each
+ *  parse scheduler. Times are the sum over the corpus of CodeObject::parse.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  struct result {
+    double ms{};
+    size_t funcs{};
+  };
+
+  result parse_corpus(std::vector<std::string> const& corpus, unsigned threads) {
+    result r;
+    for(auto const& file : corpus) {
+      auto* src = new dp::SymtabCodeSource(const_cast<char*>(file.c_str()));
+      auto* co = new dp::CodeObject(src, nullptr, nullptr, false, true);
+      co->setParseThreads(threads);
+
+      auto const start = clock_type::now();
+      co->parse();
+      r.ms += std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+      r.funcs += co->funcs().size();
+
+      delete co;
+      delete src;
+    }
+    return r;
+  }
+}
+
+int main(int argc, char** argv) {
+  unsigned max_threads = std::max(1U, std::thread::hardware_concurrency());
+  std::vector<std::string> corpus;
+  for(int i = 1; i < argc; ++i) {
+    if(!std::strcmp(argv[i], "-j") && i + 1 < argc) {
+      max_threads = std::max(1, std::atoi(argv[++i]));
+    } else {
+      corpus.emplace_back(argv[i]);
+    }
+  }
+  if(corpus.empty()) corpus.emplace_back(argv[0]);
+
+  // Always parse; never satisfy a run from the CFG cache
+  unsetenv("DYNINST_CFG_CACHE_DIR");
+
+  std::vector<unsigned> counts;
+  for(unsigned t = 1; t < max_threads; t *= 2) counts.push_back(t);
+  counts.push_back(max_threads);
+
+  std::printf("%-6s %8s %12s %8s %10s\n", "sched", "threads", "time (ms)", "speedup", "functions");
+  for(char const* sched : {"steal", "omp"}) {
+    setenv("DYNINST_PARSE_SCHEDULER", sched, 1);
+    double base = 0;
+    for(auto t : counts) {
+      auto const r = parse_corpus(corpus, t);
+      if(t == 1) base = r.ms;
+      std::printf("%-6s %8u %12.2f %8.2f %10zu\n", sched, t, r.ms, base / r.ms, r.funcs);
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+#include "Event.h"
+#include "PCProcess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <link.h>
+#include <string>
+#include <vector>
+
+namespace pc = Dyninst::ProcControlAPI;
+
+/*
+ *  Measures breakpoint round-trips: a traced process hits a breakpoint,
+ *  the event travels through the generator, mailbox and handler to a
+ *  user callback, and the process is continued.
+ *
+ *  Usage: breakpoint_roundtrip_bench [hits] [procs...]
+ *
+ *  For each process count (1, 16 and 256 by default), that many copies
+ *  of this benchmark are launched as children that call a function
+ *  `hits` times. A breakpoint on that function is continued from its
+ *  callback. Reported are the mean time per round-trip seen by one
+ *  process (latency) and the total breakpoints handled per second.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  __attribute__((noinline, used)) void tick(volatile int* counter) { ++*counter; }
+
+  int child(long hits) {
+    volatile int counter = 0;
+    for(long i = 0; i < hits; ++i)
+      tick(&counter);
+    return counter == hits ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  int on_first_object(dl_phdr_info* info, size_t, void* data) {
+    *static_cast<Dyninst::Address*>(data) = info->dlpi_addr;
+    return 1;
+  }
+
+  unsigned long breakpoints_hit = 0;
+  size_t processes_exited = 0;
+
+  pc::Process::cb_ret_t on_breakpoint(pc::Event::const_ptr) {
+    ++breakpoints_hit;
+    return pc::Process::cbProcContinue;
+  }
+
+  pc::Process::cb_ret_t on_exit(pc::Event::const_ptr) {
+    ++processes_exited;
+    return pc::Process::cbDefault;
+  }
+
+  bool run(std::string const& exe, long hits, size_t nprocs, Dyninst::Address tick_offset) {
+    std::vector<std::string> args{exe, "child", std::to_string(hits)};
+    std::vector<pc::Process::ptr> procs;
+    pc::Breakpoint::ptr bp = pc::Breakpoint::newBreakpoint();
+    for(size_t i = 0; i < nprocs; ++i) {
+      pc::Process::ptr proc = pc::Process::createProcess(exe, args);
+      if(!proc) {
+        std::fprintf(stderr, "Unable to launch child %zu\n", i);
+        break;
+      }
+      Dyninst::Address load = proc->libraries().getExecutable()->getLoadAddress();
+      if(!proc->addBreakpoint(load + tick_offset, bp)) {
+        std::fprintf(stderr, "Unable to insert breakpoint in %d\n", proc->getPid());
+        proc->terminate();
+        break;
+      }
+      procs.push_back(proc);
+    }
+    if(procs.size() != nprocs) {
+      for(auto& p : procs)
+        p->terminate();
+      return false;
+    }
+
+    breakpoints_hit = 0;
+    processes_exited = 0;
+    auto start = clock_type::now();
+    for(auto& p : procs)
+      p->continueProc();
+    while(processes_exited < nprocs)
+      pc::Process::handleEvents(true);
+    double const secs = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    unsigned long const expected = static_cast<unsigned long>(hits) * nprocs;
+    std::printf("%8zu %12lu %12.2f %14.0f\n", nprocs, breakpoints_hit,
+                hits ? secs * 1e6 / hits : 0.0, secs ? breakpoints_hit / secs : 0.0);
+    if(breakpoints_hit != expected) {
+      std::fprintf(stderr, "Expected %lu breakpoints, saw %lu\n", expected, breakpoints_hit);
+      return false;
+    }
+    return true;
+  }
+}
+
+int main(int argc, char** argv) {
+  if(argc > 2 && !std::strcmp(argv[1], "child"))
+    return child(std::strtol(argv[2], nullptr, 10));
+
+  long const hits = (argc > 1) ? std::max(std::strtol(argv[1], nullptr, 10), 1L) : 200;
+  std::vector<size_t> counts;
+  for(int i = 2; i < argc; ++i)
+    counts.push_back(std::strtoul(argv[i], nullptr, 10));
+  if(counts.empty())
+    counts = {1, 16, 256};
+
+  Dyninst::Address self_load = 0;
+  dl_iterate_phdr(on_first_object, &self_load);
+  Dyninst::Address const tick_offset = reinterpret_cast<Dyninst::Address>(&tick) - self_load;
+
+  pc::Process::registerEventCallback(pc::EventType(pc::EventType::Breakpoint), on_breakpoint);
+  pc::Process::registerEventCallback(pc::EventType(pc::EventType::Post, pc::EventType::Terminate), on_exit);
+
+  std::printf("%ld breakpoints per process\n", hits);
+  std::printf("%8s %12s %12s %14s\n", "procs", "breakpoints", "us/trip", "trips/sec");
+  for(size_t n : counts) {
+    if(n && !run(argv[0], hits, n, tick_offset))
+      return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+#include "Event.h"
+#include "PCProcess.h"
+#include "registers/x86_64_regs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace pc = Dyninst::ProcControlAPI;
+
+/*
+ *  Measures posting many inferior RPCs to one thread, each on its own and
+ *  as a single batch.
+ *
+ *  Usage: irpc_batch_bench [rpcs] [rounds]
+ *
+ *  A copy of this benchmark is launched as a child. Each round posts `rpcs`
+ *  small iRPCs that load their index into %rax and trap, waits until all of
+ *  them are done, and checks that every RPC callback saw its own index.
+ *  A batch runs as one fused blob with a single stop and continue.
+ *  Reported is the mean time per RPC for each mode.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  size_t rpcs_done = 0;
+  size_t rpcs_wrong = 0;
+
+  pc::Process::cb_ret_t on_rpc(pc::Event::const_ptr ev) {
+    pc::IRPC::const_ptr rpc = ev->getEventRPC()->getIRPC();
+    // Batched RPCs report the registers they left; the thread has moved on
+    Dyninst::MachRegisterVal rax = 0;
+    bool const have = rpc->getResultRegister(Dyninst::x86_64::rax, rax) ||
+                      ev->getThread()->getRegister(Dyninst::x86_64::rax, rax);
+    if(!have || rax != reinterpret_cast<uintptr_t>(rpc->getData()))
+      ++rpcs_wrong;
+    ++rpcs_done;
+    return pc::Process::cbDefault;
+  }
+
+  // mov $imm32, %eax; int3
+  std::vector<unsigned char> blob(uint32_t index) {
+    std::vector<unsigned char> code{0xb8, 0, 0, 0, 0, 0xcc};
+    std::memcpy(&code[1], &index, sizeof(index));
+    return code;
+  }
+
+  bool run(pc::Thread::const_ptr thr, size_t count, bool batch, double& secs) {
+    std::vector<std::vector<unsigned char>> code;
+    std::vector<pc::IRPC::ptr> rpcs;
+    for(size_t i = 0; i < count; ++i) {
+      code.push_back(blob(static_cast<uint32_t>(i)));
+      pc::IRPC::ptr rpc = pc::IRPC::createIRPC(code.back().data(), code.back().size());
+      rpc->setData(reinterpret_cast<void*>(i));
+      rpcs.push_back(rpc);
+    }
+
+    rpcs_done = 0;
+    rpcs_wrong = 0;
+    auto start = clock_type::now();
+    if(batch) {
+      if(!thr->postIRPCBatch(rpcs)) return false;
+    } else {
+      for(auto& rpc : rpcs)
+        if(!thr->postIRPC(rpc)) return false;
+    }
+    while(rpcs.back()->state() != pc::IRPC::Done)
+      if(!pc::Process::handleEvents(true)) return false;
+    secs = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    if(rpcs_done != count || rpcs_wrong) {
+      std::fprintf(stderr, "%zu of %zu RPCs completed, %zu with the wrong result\n", rpcs_done, count,
+                   rpcs_wrong);
+      return false;
+    }
+    return true;
+  }
+}
+
+int main(int argc, char** argv) {
+  if(argc > 1 && !std::strcmp(argv[1], "child")) {
+    pause();
+    return EXIT_SUCCESS;
+  }
+
+  size_t const count = (argc > 1) ? std::max(std::strtoul(argv[1], nullptr, 10), 1UL) : 256;
+  int const rounds = (argc > 2) ? std::max(std::atoi(argv[2]), 1) : 5;
+
+  std::vector<std::string> args{argv[0], "child"};
+  pc::Process::ptr proc = pc::Process::createProcess(argv[0], args);
+  if(!proc) {
+    std::fprintf(stderr, "Unable to launch child\n");
+    return EXIT_FAILURE;
+  }
+  pc::Process::registerEventCallback(pc::EventType(pc::EventType::RPC), on_rpc);
+  pc::Thread::const_ptr thr = proc->threads().getInitialThread();
+
+  int status = EXIT_SUCCESS;
+  std::printf("%zu RPCs per round, %d rounds\n", count, rounds);
+  std::printf("%-10s %12s %12s\n", "mode", "us/rpc", "rpcs/sec");
+  for(bool batch : {false, true}) {
+    double total = 0.0;
+    for(int r = 0; r < rounds && status == EXIT_SUCCESS; ++r) {
+      double secs = 0.0;
+      if(!run(thr, count, batch, secs)) {
+        std::fprintf(stderr, "%s round %d failed\n", batch ? "Batched" : "Single", r);
+        status = EXIT_FAILURE;
+      }
+      total += secs;
+    }
+    if(status != EXIT_SUCCESS) break;
+    double const n = static_cast<double>(count) * rounds;
+    std::printf("%-10s %12.2f %12.0f\n", batch ? "batch" : "single", total * 1e6 / n, total ? n / total : 0.0);
+  }
+
+  proc->terminate();
+  return status;
+}
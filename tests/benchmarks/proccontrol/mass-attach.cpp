@@ -0,0 +1,131 @@
+#include "PCProcess.h"
+#include "ProcessSet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace pc = Dyninst::ProcControlAPI;
+
+/*
+ *  Measures ProcessSet::attachProcessSet against a growing number of
+ *  already-running processes.
+ *
+ *  Usage: mass_attach_bench [max_procs] [threads_per_proc]
+ *
+ *  Copies of this benchmark are started, without being traced, as children
+ *  that sleep on each of their threads. They are attached to in sets of
+ *  1, 2, 4, ... max_procs, once with library discovery and thread_db set up
+ *  during the attach and once with both deferred, and then detached again.
+ *  The time spent in each phase of the attach is reported.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  int child(int nthreads) {
+    std::vector<std::thread> threads;
+    for(int i = 1; i < nthreads; ++i)
+      threads.emplace_back([] { pause(); });
+    pause();
+    for(auto& t : threads)
+      t.join();
+    return EXIT_SUCCESS;
+  }
+
+  pid_t spawn(char const* exe, int nthreads) {
+    pid_t pid = fork();
+    if(pid == 0) {
+      std::string const n = std::to_string(nthreads);
+      execl(exe, exe, "child", n.c_str(), static_cast<char*>(nullptr));
+      _exit(EXIT_FAILURE);
+    }
+    return pid;
+  }
+
+  bool attach(std::vector<pid_t> const& pids, size_t nprocs, char const* exe, bool defer) {
+    std::vector<pc::ProcessSet::AttachInfo> ainfo(nprocs);
+    for(size_t i = 0; i < nprocs; ++i) {
+      ainfo[i].pid = pids[i];
+      ainfo[i].executable = exe;
+    }
+
+    pc::ProcessSet::AttachTimings t{};
+    auto start = clock_type::now();
+    pc::ProcessSet::ptr set = pc::ProcessSet::attachProcessSet(ainfo, defer, &t);
+    double const total = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+
+    size_t const attached = set ? set->size() : 0;
+    std::printf("%8zu %-8s %10.2f %10.2f %10.2f %10.2f %10.2f\n", nprocs, defer ? "deferred" : "eager",
+                t.attach * 1e3, t.stop * 1e3, t.threads * 1e3, t.post_attach * 1e3, total);
+    if(attached != nprocs) {
+      std::fprintf(stderr, "Attached to %zu of %zu processes\n", attached, nprocs);
+      if(set) set->detach();
+      return false;
+    }
+
+    // A deferred attach still has to produce libraries when asked
+    if(defer && !(*set->begin())->libraries().getExecutable()) {
+      std::fprintf(stderr, "No executable after a deferred attach to %d\n", pids[0]);
+      set->detach();
+      return false;
+    }
+    return set->detach();
+  }
+}
+
+int main(int argc, char** argv) {
+  if(argc > 2 && !std::strcmp(argv[1], "child"))
+    return child(std::atoi(argv[2]));
+
+  size_t const max_procs = (argc > 1) ? std::max(std::strtoul(argv[1], nullptr, 10), 1UL) : 64;
+  int const nthreads = (argc > 2) ? std::max(std::atoi(argv[2]), 1) : 4;
+
+  std::vector<pid_t> pids;
+  for(size_t i = 0; i < max_procs; ++i) {
+    pid_t pid = spawn(argv[0], nthreads);
+    if(pid < 0) {
+      std::fprintf(stderr, "Unable to launch child %zu\n", i);
+      break;
+    }
+    pids.push_back(pid);
+  }
+
+  // Give the children time to start their threads
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  std::vector<size_t> counts;
+  for(size_t n = 1; n < pids.size(); n *= 2)
+    counts.push_back(n);
+  if(!pids.empty())
+    counts.push_back(pids.size());
+
+  int status = pids.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+  std::printf("%zu children, %d threads each\n", pids.size(), nthreads);
+  std::printf("%8s %-8s %10s %10s %10s %10s %10s\n", "procs", "mode", "attach ms", "stop ms",
+              "threads ms", "post ms", "total ms");
+
+  for(size_t n : counts) {
+    if(status != EXIT_SUCCESS) break;
+    for(bool defer : {false, true}) {
+      if(!attach(pids, n, argv[0], defer)) {
+        status = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  for(pid_t pid : pids) {
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+  }
+  return status;
+}
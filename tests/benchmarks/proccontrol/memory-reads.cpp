@@ -0,0 +1,149 @@
+#include "PCProcess.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace pc = Dyninst::ProcControlAPI;
+
+/*
+ *  Measures small remote memory reads per second against a local child.
+ *
+ *  Usage: memory_reads_bench [executable] [reads] [batch]
+ *
+ *  The executable (this benchmark by default) is launched stopped at its
+ *  entry point. Word-sized reads scattered over its largest readable
+ *  mapping are issued once with Process::readMemory and once through
+ *  Process::readMemoryV in batches, the way a stack walker touches a
+ *  handful of nearby frame slots per step. The single reads are then
+ *  repeated with the page read cache enabled. All passes must agree.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  double ms_since(clock_type::time_point start) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+  }
+
+  bool find_region(Dyninst::PID pid, Dyninst::Address& start, Dyninst::Address& end) {
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    std::string line;
+    start = end = 0;
+    while(std::getline(maps, line)) {
+      std::istringstream in(line);
+      std::string range, perms;
+      in >> range >> perms;
+      if(perms.empty() || perms[0] != 'r') continue;
+      if(line.find("[vvar") != std::string::npos || line.find("[vsyscall]") != std::string::npos)
+        continue;
+      auto dash = range.find('-');
+      auto lo = std::strtoul(range.substr(0, dash).c_str(), nullptr, 16);
+      auto hi = std::strtoul(range.substr(dash + 1).c_str(), nullptr, 16);
+      if(hi - lo > end - start) {
+        start = lo;
+        end = hi;
+      }
+    }
+    return end > start;
+  }
+
+  void print(char const* mode, size_t reads, double ms) {
+    std::printf("%-10s %10zu %10.2f %14.0f\n", mode, reads, ms, ms ? reads / (ms / 1000.0) : 0.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string const file = (argc > 1) ? argv[1] : argv[0];
+  size_t const nreads = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 200000;
+  size_t const batch = (argc > 3) ? std::max(std::strtoul(argv[3], nullptr, 10), 1UL) : 64;
+
+  std::vector<std::string> args{file};
+  pc::Process::ptr proc = pc::Process::createProcess(file, args);
+  if(!proc) {
+    std::fprintf(stderr, "Unable to launch '%s'\n", file.c_str());
+    return EXIT_FAILURE;
+  }
+
+  Dyninst::Address lo{}, hi{};
+  if(!find_region(proc->getPid(), lo, hi)) {
+    std::fprintf(stderr, "No readable mapping in %d\n", proc->getPid());
+    proc->terminate();
+    return EXIT_FAILURE;
+  }
+
+  // Clusters of nearby words, like the slots of one stack frame
+  std::mt19937_64 rng(42);
+  size_t const words = (hi - lo) / sizeof(uint64_t);
+  std::vector<Dyninst::Address> addrs(nreads);
+  for(size_t i = 0; i < nreads; i += 8) {
+    size_t base = rng() % (words > 64 ? words - 64 : 1);
+    for(size_t j = i; j < nreads && j < i + 8; ++j)
+      addrs[j] = lo + (base + rng() % 64) * sizeof(uint64_t);
+  }
+
+  std::printf("%s: pid %d, region 0x%lx-0x%lx, %zu reads, batch %zu\n", file.c_str(),
+              proc->getPid(), lo, hi, nreads, batch);
+  std::printf("%-10s %10s %10s %14s\n", "mode", "reads", "ms", "reads/sec");
+
+  std::vector<uint64_t> single(nreads), vectored(nreads);
+  auto start = clock_type::now();
+  for(size_t i = 0; i < nreads; ++i) {
+    if(!proc->readMemory(&single[i], addrs[i], sizeof(uint64_t))) {
+      std::fprintf(stderr, "readMemory failed at 0x%lx\n", addrs[i]);
+      proc->terminate();
+      return EXIT_FAILURE;
+    }
+  }
+  print("single", nreads, ms_since(start));
+
+  std::vector<pc::Process::mem_segment_t> segs;
+  start = clock_type::now();
+  for(size_t i = 0; i < nreads; i += batch) {
+    segs.clear();
+    for(size_t j = i; j < nreads && j < i + batch; ++j)
+      segs.push_back({addrs[j], &vectored[j], sizeof(uint64_t), pc::err_none});
+    if(!proc->readMemoryV(segs)) {
+      std::fprintf(stderr, "readMemoryV failed in batch at %zu\n", i);
+      proc->terminate();
+      return EXIT_FAILURE;
+    }
+  }
+  print("vectored", nreads, ms_since(start));
+
+  std::vector<uint64_t> cached(nreads);
+  proc->setMemoryReadCache(true);
+  start = clock_type::now();
+  for(size_t i = 0; i < nreads; ++i) {
+    if(!proc->readMemory(&cached[i], addrs[i], sizeof(uint64_t))) {
+      std::fprintf(stderr, "Cached readMemory failed at 0x%lx\n", addrs[i]);
+      proc->terminate();
+      return EXIT_FAILURE;
+    }
+  }
+  print("cached", nreads, ms_since(start));
+
+  unsigned long hits{}, misses{};
+  proc->getMemoryReadCacheStats(hits, misses);
+  std::printf("read cache: %lu page hits, %lu page misses\n", hits, misses);
+
+  proc->terminate();
+
+  if(std::memcmp(single.data(), vectored.data(), nreads * sizeof(uint64_t)) != 0) {
+    std::fprintf(stderr, "Vectored reads disagree with single reads\n");
+    return EXIT_FAILURE;
+  }
+  if(std::memcmp(single.data(), cached.data(), nreads * sizeof(uint64_t)) != 0) {
+    std::fprintf(stderr, "Cached reads disagree with single reads\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
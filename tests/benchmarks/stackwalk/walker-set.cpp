@@ -0,0 +1,147 @@
+#include "frame.h"
+#include "procstate.h"
+#include "walker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sw = Dyninst::Stackwalker;
+
+/*
+ *  Measures WalkerSet::walkStacks as the number of processes grows.
+ *
+ *  Usage: walker_set_bench [max_procs] [threads_per_proc] [depth]
+ *
+ *  Copies of this benchmark are launched as children that spin at the
+ *  bottom of a recursion of the given depth on each of their threads.
+ *  Stacks are collected from 1, 2, 4, ... max_procs of them, once with a
+ *  single walker thread and once with the default pool, and the cost per
+ *  thread stack is reported.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  std::atomic<bool> spinning{true};
+
+  __attribute__((noinline)) int recurse(int depth) {
+    if(depth <= 0) {
+      while(spinning.load(std::memory_order_relaxed)) {
+      }
+      return 0;
+    }
+    return recurse(depth - 1) + 1;
+  }
+
+  int child(int nthreads, int depth) {
+    std::vector<std::thread> threads;
+    for(int i = 1; i < nthreads; ++i)
+      threads.emplace_back([depth] { recurse(depth); });
+    recurse(depth);
+    for(auto& t : threads)
+      t.join();
+    return EXIT_SUCCESS;
+  }
+
+  size_t count_threads(sw::FrameNode const* node) {
+    if(node->isThread())
+      return 1;
+    size_t n = 0;
+    for(auto const* c : node->getChildren())
+      n += count_threads(c);
+    return n;
+  }
+
+  bool collect(std::vector<sw::Walker*> const& walkers, size_t nprocs, unsigned threads,
+               size_t& stacks, double& ms) {
+    sw::WalkerSet* set = sw::WalkerSet::newWalkerSet();
+    for(size_t i = 0; i < nprocs; ++i)
+      set->insert(walkers[i]);
+    set->setWalkThreads(threads);
+
+    sw::CallTree tree;
+    auto start = clock_type::now();
+    bool ok = set->walkStacks(tree);
+    ms = std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    stacks = count_threads(tree.getHead());
+
+    // Leave the walkers alive for the next pass
+    while(!set->empty())
+      set->erase(set->begin());
+    delete set;
+    return ok;
+  }
+
+  void print(size_t procs, unsigned threads, size_t stacks, double ms) {
+    std::printf("%8zu %8u %8zu %10.2f %14.1f\n", procs, threads, stacks, ms,
+                stacks ? ms * 1000.0 / stacks : 0.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  if(argc > 3 && !std::strcmp(argv[1], "child"))
+    return child(std::atoi(argv[2]), std::atoi(argv[3]));
+
+  size_t const max_procs = (argc > 1) ? std::max(std::strtoul(argv[1], nullptr, 10), 1UL) : 16;
+  int const nthreads = (argc > 2) ? std::max(std::atoi(argv[2]), 1) : 2;
+  int const depth = (argc > 3) ? std::max(std::atoi(argv[3]), 0) : 32;
+
+  std::vector<std::string> args{argv[0], "child", std::to_string(nthreads), std::to_string(depth)};
+  std::vector<sw::Walker*> walkers;
+  for(size_t i = 0; i < max_procs; ++i) {
+    sw::Walker* w = sw::Walker::newWalker(argv[0], args);
+    if(!w) {
+      std::fprintf(stderr, "Unable to launch child %zu\n", i);
+      break;
+    }
+    walkers.push_back(w);
+    auto* pd = dynamic_cast<sw::ProcDebug*>(w->getProcessState());
+    if(pd) pd->getProc()->continueProc();
+  }
+
+  // Give the children time to start their threads and reach the spin loop
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  sw::WalkerSet* defaults = sw::WalkerSet::newWalkerSet();
+  unsigned const pool = defaults->getWalkThreads();
+  delete defaults;
+
+  std::vector<size_t> counts;
+  for(size_t n = 1; n < walkers.size(); n *= 2)
+    counts.push_back(n);
+  if(!walkers.empty())
+    counts.push_back(walkers.size());
+
+  int status = walkers.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+  std::printf("%zu children, %d threads each, depth %d\n", walkers.size(), nthreads, depth);
+  std::printf("%8s %8s %8s %10s %14s\n", "procs", "workers", "stacks", "ms", "us/stack");
+
+  for(size_t n : counts) {
+    if(status != EXIT_SUCCESS) break;
+    for(unsigned threads : {1U, pool}) {
+      size_t stacks{};
+      double ms{};
+      if(!collect(walkers, n, threads, stacks, ms)) {
+        std::fprintf(stderr, "walkStacks failed for %zu processes on %u threads\n", n, threads);
+        status = EXIT_FAILURE;
+        break;
+      }
+      print(n, threads, stacks, ms);
+      if(threads == pool) break;
+    }
+  }
+
+  for(auto* w : walkers) {
+    auto* pd = dynamic_cast<sw::ProcDebug*>(w->getProcessState());
+    if(pd) pd->getProc()->terminate();
+    delete w;
+  }
+  return status;
+}
@@ -0,0 +1,84 @@
+#include "Symtab.h"
+#include "Symbol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace st = Dyninst::SymtabAPI;
+
+/*
+ *  Reports the hit rate of the shared demangler cache on a real binary.
+ *
+ *  Usage: demangle_cache_bench [binary] [threads]
+ *
+ *  Each pass asks every symbol for its pretty and typed names, split
+ *  across the threads. The first pass fills the cache, the second shows
+ *  what repeated lookups (e.g. from several tools or parse threads) cost.
+ *  Set DYNINST_DEMANGLE_CACHE_SIZE to compare capacities; 0 disables it.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  double ms_since(clock_type::time_point start) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+  }
+
+  double run_pass(std::vector<st::Symbol*> const& syms, unsigned nthreads) {
+    auto start = clock_type::now();
+    std::vector<std::thread> threads;
+    for(unsigned t = 0; t < nthreads; ++t) {
+      threads.emplace_back([&syms, t, nthreads]() {
+        size_t len = 0;
+        for(size_t i = t; i < syms.size(); i += nthreads) {
+          len += syms[i]->getPrettyName().size();
+          len += syms[i]->getTypedName().size();
+        }
+        if(!len) std::fprintf(stderr, "thread %u saw no names\n", t);
+      });
+    }
+    for(auto& th : threads) th.join();
+    return ms_since(start);
+  }
+
+  void print(char const* pass, double ms) {
+    auto s = st::Symtab::getDemangleCacheStats();
+    double lookups = static_cast<double>(s.hits + s.misses);
+    std::printf("%-6s %10.2f %10lu %10lu %9.1f%% %10lu %10lu %10lu\n", pass, ms, s.hits, s.misses,
+                lookups ? 100.0 * s.hits / lookups : 0.0, s.evictions, s.entries, s.interned);
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string const file = (argc > 1) ? argv[1] : argv[0];
+  unsigned nthreads = (argc > 2) ? std::strtoul(argv[2], nullptr, 10)
+                                 : std::thread::hardware_concurrency();
+  nthreads = std::max(nthreads, 1U);
+
+  st::Symtab* obj{};
+  if(!st::Symtab::openFile(obj, file)) {
+    std::fprintf(stderr, "Unable to open '%s'\n", file.c_str());
+    return EXIT_FAILURE;
+  }
+  std::vector<st::Symbol*> syms;
+  if(!obj->getAllSymbols(syms)) {
+    std::fprintf(stderr, "No symbols in '%s'\n", file.c_str());
+    st::Symtab::closeSymtab(obj);
+    return EXIT_FAILURE;
+  }
+
+  std::printf("%s: %zu symbols, %u threads, cache capacity %lu\n", file.c_str(), syms.size(),
+              nthreads, st::Symtab::getDemangleCacheStats().capacity);
+  std::printf("%-6s %10s %10s %10s %10s %10s %10s %10s\n", "pass", "ms", "hits", "misses",
+              "hit rate", "evictions", "entries", "interned");
+  print("cold", run_pass(syms, nthreads));
+  print("warm", run_pass(syms, nthreads));
+
+  st::Symtab::closeSymtab(obj);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#include "Symtab.h"
+#include "Function.h"
+#include "Module.h"
+#include "Type.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace st = Dyninst::SymtabAPI;
+
+/*
+ *  Compares eager DWARF type parsing with lazy, per-module parsing.
+ *
+ *  Usage: lazy_types_bench [binary]
+ *
+ *  For each mode this reopens the binary and times the queries a tool
+ *  typically makes, in order: one function's locals, its module's types,
+ *  and finally every module's types. Eager mode pays for everything on
+ *  the first query; lazy mode only for the module being asked about.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  double ms_since(clock_type::time_point start) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+  }
+
+  struct result {
+    double open{}, locals{}, module_types{}, all_types{};
+    size_t num_locals{}, num_types{};
+  };
+
+  bool run(std::string const& file, bool lazy, result& r) {
+    auto start = clock_type::now();
+    st::Symtab* obj{};
+    if(!st::Symtab::openFile(obj, file)) {
+      std::fprintf(stderr, "Unable to open '%s'\n", file.c_str());
+      return false;
+    }
+    if(lazy && !obj->setLazyTypeParsing(true)) {
+      std::fprintf(stderr, "Lazy type parsing is not available for '%s'\n", file.c_str());
+      st::Symtab::closeSymtab(obj);
+      return false;
+    }
+    r.open = ms_since(start);
+
+    std::vector<st::Function*> funcs;
+    if(!obj->findFunctionsByName(funcs, "main")) {
+      std::fprintf(stderr, "No 'main' in '%s'\n", file.c_str());
+      st::Symtab::closeSymtab(obj);
+      return false;
+    }
+
+    start = clock_type::now();
+    std::vector<st::localVar*> vars;
+    funcs.front()->getLocalVariables(vars);
+    funcs.front()->getParams(vars);
+    r.locals = ms_since(start);
+    r.num_locals = vars.size();
+
+    start = clock_type::now();
+    std::vector<boost::shared_ptr<st::Type>> types;
+    funcs.front()->getModule()->getAllTypes(types);
+    r.module_types = ms_since(start);
+
+    start = clock_type::now();
+    std::vector<st::Module*> mods;
+    obj->getAllModules(mods);
+    r.num_types = 0;
+    for(auto* m : mods) {
+      types.clear();
+      m->getAllTypes(types);
+      r.num_types += types.size();
+    }
+    r.all_types = ms_since(start);
+
+    st::Symtab::closeSymtab(obj);
+    return true;
+  }
+
+  void print(char const* mode, result const& r) {
+    std::printf("%-6s %10.2f %10.2f %13.2f %10.2f %10.2f\n", mode, r.open, r.locals,
+                r.module_types, r.all_types, r.open + r.locals + r.module_types + r.all_types);
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string const file = (argc > 1) ? argv[1] : argv[0];
+
+  result eager, lazy;
+  if(!run(file, false, eager) || !run(file, true, lazy)) return EXIT_FAILURE;
+
+  std::printf("%s\n", file.c_str());
+  std::printf("%-6s %10s %10s %13s %10s %10s\n", "mode", "open", "locals", "module types",
+              "all types", "total");
+  print("eager", eager);
+  print("lazy", lazy);
+
+  if(eager.num_locals != lazy.num_locals || eager.num_types != lazy.num_types) {
+    std::fprintf(stderr, "Mismatch: eager found %zu locals and %zu types, lazy %zu and %zu\n",
+                 eager.num_locals, eager.num_types, lazy.num_locals, lazy.num_types);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
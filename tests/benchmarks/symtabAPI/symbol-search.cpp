@@ -0,0 +1,89 @@
+#include "Symtab.h"
+#include "Symbol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace st = Dyninst::SymtabAPI;
+
+/*
+ *  Times wildcard symbol searches against the symbol name index.
+ *
+ *  Usage: symbol_search_bench [binary] [queries]
+ *
+ *  Queries are derived from the binary's own pretty names: half are
+ *  prefix patterns ("name*") and half substring patterns ("*part*").
+ *  They are run once through findSymbol one at a time (the first call
+ *  also builds the index) and once as a single findSymbols batch.
+ */
+
+namespace {
+  using clock_type = std::chrono::steady_clock;
+
+  double ms_since(clock_type::time_point start) {
+    return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+  }
+}
+
+int main(int argc, char** argv) {
+  std::string const file = (argc > 1) ? argv[1] : argv[0];
+  size_t const nqueries = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+  st::Symtab* obj{};
+  if(!st::Symtab::openFile(obj, file)) {
+    std::fprintf(stderr, "Unable to open '%s'\n", file.c_str());
+    return EXIT_FAILURE;
+  }
+  std::vector<st::Symbol*> syms;
+  obj->getAllDefinedSymbols(syms);
+  if(syms.empty()) {
+    std::fprintf(stderr, "No symbols in '%s'\n", file.c_str());
+    st::Symtab::closeSymtab(obj);
+    return EXIT_FAILURE;
+  }
+
+  std::vector<st::Symtab::SymbolQuery> queries;
+  size_t const step = std::max<size_t>(1, syms.size() / std::max<size_t>(1, nqueries));
+  for(size_t i = 0; i < syms.size() && queries.size() < nqueries; i += step) {
+    std::string const name = syms[i]->getPrettyName();
+    if(name.size() < 8) continue;
+    if(queries.size() % 2)
+      queries.emplace_back(name.substr(0, name.size() / 2) + "*");
+    else
+      queries.emplace_back("*" + name.substr(name.size() / 4, name.size() / 2) + "*");
+  }
+
+  auto start = clock_type::now();
+  size_t single_matches = 0;
+  for(auto const& q : queries) {
+    std::vector<st::Symbol*> found;
+    obj->findSymbol(found, q.pattern, q.type, q.nameType, true, q.checkCase);
+    single_matches += found.size();
+  }
+  double const single = ms_since(start);
+
+  start = clock_type::now();
+  std::vector<std::vector<st::Symbol*>> found;
+  obj->findSymbols(found, queries);
+  double const batch = ms_since(start);
+  size_t batch_matches = 0;
+  for(auto const& f : found) batch_matches += f.size();
+
+  std::printf("%s: %zu symbols, %zu queries\n", file.c_str(), syms.size(), queries.size());
+  std::printf("%-12s %10s %10s\n", "mode", "ms", "matches");
+  std::printf("%-12s %10.2f %10zu\n", "findSymbol", single, single_matches);
+  std::printf("%-12s %10.2f %10zu\n", "findSymbols", batch, batch_matches);
+
+  st::Symtab::closeSymtab(obj);
+
+  if(single_matches != batch_matches) {
+    std::fprintf(stderr, "Mismatch: findSymbol found %zu, findSymbols %zu\n", single_matches,
+                 batch_matches);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
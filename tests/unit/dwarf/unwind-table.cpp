@@ -0,0 +1,132 @@
+#include "dwarf/h/dwarfFrameParser.h"
+#include "VariableLocation.h"
+#include "dyn_regs.h"
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <libelf.h>
+#include <unistd.h>
+#include <vector>
+
+namespace dw = Dyninst::DwarfDyninst;
+
+/*
+ *  Checks the precompiled CFI unwind table of this executable against the
+ *  full CFI evaluator, and that UnwindTable keeps its rows sorted and
+ *  disjoint.
+ */
+
+namespace {
+  dw::UnwindRow make_row(Dyninst::Address start, Dyninst::Address end) {
+    dw::UnwindRow r;
+    r.start = start;
+    r.end = end;
+    return r;
+  }
+
+  bool check_synthetic() {
+    std::vector<dw::UnwindRow> rows = {
+        make_row(0x300, 0x340), make_row(0x100, 0x180), make_row(0x200, 0x200),
+        make_row(0x170, 0x1a0), make_row(0x180, 0x1c0)};
+    dw::UnwindTable table(rows);
+
+    // The empty row and the one overlapping [0x100, 0x180) are dropped
+    if(table.size() != 3) {
+      std::cerr << "Expected 3 rows, found " << table.size() << '\n';
+      return false;
+    }
+    struct {
+      Dyninst::Address pc, start;
+    } const hits[] = {{0x100, 0x100}, {0x17f, 0x100}, {0x180, 0x180}, {0x33f, 0x300}};
+    for(auto const& h : hits) {
+      auto const* row = table.find(h.pc);
+      if(!row || row->start != h.start) {
+        std::cerr << "Wrong row for 0x" << std::hex << h.pc << std::dec << '\n';
+        return false;
+      }
+    }
+    Dyninst::Address const misses[] = {0xff, 0x1c0, 0x200, 0x2ff, 0x340};
+    for(auto pc : misses) {
+      if(table.find(pc)) {
+        std::cerr << "Unexpected row for 0x" << std::hex << pc << std::dec << '\n';
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool check_file(char const* file, Dyninst::Architecture arch) {
+    elf_version(EV_CURRENT);
+    int fd = open(file, O_RDONLY);
+    if(fd < 0) {
+      std::cerr << "Unable to open '" << file << "'\n";
+      return false;
+    }
+    Elf* elf = elf_begin(fd, ELF_C_READ_MMAP, nullptr);
+    Dwarf* dbg = elf ? dwarf_begin_elf(elf, DWARF_C_READ, nullptr) : nullptr;
+
+    bool ok = true;
+    auto parser = dw::DwarfFrameParser::create(dbg, elf, arch);
+    auto table = parser ? parser->getUnwindTable() : dw::UnwindTable::Ptr();
+    if(!table || !table->size()) {
+      std::cerr << "No unwind rows for '" << file << "'\n";
+      ok = false;
+    } else {
+      Dyninst::Address last_end = 0;
+      size_t compared = 0;
+      for(auto const& row : table->rows()) {
+        if(row.start >= row.end || row.start < last_end) {
+          std::cerr << "Row [0x" << std::hex << row.start << ", 0x" << row.end << std::dec
+                    << ") is empty or out of order\n";
+          ok = false;
+          break;
+        }
+        last_end = row.end;
+        if(table->find(row.start) != &row || table->find(row.end - 1) != &row) {
+          std::cerr << "find() misses row at 0x" << std::hex << row.start << std::dec << '\n';
+          ok = false;
+          break;
+        }
+        if(row.cfa.kind != dw::UnwindRule::RegOffset)
+          continue;
+
+        // The full evaluator must agree on every compiled CFA rule
+        Dyninst::VariableLocation loc;
+        dw::FrameErrors_t err;
+        if(!parser->getRegRepAtFrame(row.start, Dyninst::CFA, loc, err) ||
+           loc.mr_reg != row.cfa.reg || loc.frameOffset != row.cfa.offset) {
+          std::cerr << "CFA at 0x" << std::hex << row.start << std::dec << " is "
+                    << row.cfa.reg.name() << "+" << row.cfa.offset << ", evaluator says "
+                    << loc.mr_reg.name() << "+" << loc.frameOffset << '\n';
+          ok = false;
+          break;
+        }
+        ++compared;
+      }
+      if(ok && !compared) {
+        std::cerr << "No register+offset CFA rules in '" << file << "'\n";
+        ok = false;
+      }
+    }
+
+    if(dbg) dwarf_end(dbg);
+    if(elf) elf_end(elf);
+    close(fd);
+    return ok;
+  }
+}
+
+int main(int, char** argv) {
+  if(!check_synthetic()) return EXIT_FAILURE;
+
+#if defined(__x86_64__)
+  if(!check_file(argv[0], Dyninst::Arch_x86_64)) return EXIT_FAILURE;
+#elif defined(__aarch64__)
+  if(!check_file(argv[0], Dyninst::Arch_aarch64)) return EXIT_FAILURE;
+#else
+  (void)argv;
+#endif
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+#include "BPatch.h"
+#include "BPatch_binaryEdit.h"
+#include "BPatch_function.h"
+#include "BPatch_image.h"
+
+#include "ABI.h"
+#include "dyninstAPI/src/function.h"
+#include "dyninstAPI/src/parse-cfg.h"
+#include "dyn_regs.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/*
+ *  Checks the register write summaries parse_func::callWrittenRegs builds
+ *  for snippet calls, on functions whose exact instructions are given here.
+ */
+
+// clang-format off
+asm(R"(
+  .text
+  .globl cwr_leaf
+  .type cwr_leaf, @function
+cwr_leaf:
+  mov $1, %eax
+  ret
+  .size cwr_leaf, .-cwr_leaf
+
+  .globl cwr_calls_leaf
+  .type cwr_calls_leaf, @function
+cwr_calls_leaf:
+  xor %ecx, %ecx
+  call cwr_leaf
+  ret
+  .size cwr_calls_leaf, .-cwr_calls_leaf
+
+  .globl cwr_saves_rbx
+  .type cwr_saves_rbx, @function
+cwr_saves_rbx:
+  push %rbx
+  mov $2, %ebx
+  pop %rbx
+  ret
+  .size cwr_saves_rbx, .-cwr_saves_rbx
+
+  .globl cwr_recursive
+  .type cwr_recursive, @function
+cwr_recursive:
+  test %edi, %edi
+  je 1f
+  dec %edi
+  call cwr_recursive
+1:
+  mov $3, %edx
+  ret
+  .size cwr_recursive, .-cwr_recursive
+
+  .globl cwr_indirect
+  .type cwr_indirect, @function
+cwr_indirect:
+  call *%rsi
+  ret
+  .size cwr_indirect, .-cwr_indirect
+
+  .globl cwr_vector
+  .type cwr_vector, @function
+cwr_vector:
+  pxor %xmm0, %xmm0
+  ret
+  .size cwr_vector, .-cwr_vector
+)");
+// clang-format on
+
+namespace {
+  namespace x64 = Dyninst::x86_64;
+
+  parse_func* find(BPatch_image* image, char const* name) {
+    BPatch_Vector<BPatch_function*> funcs;
+    image->findFunction(name, funcs);
+    if(funcs.empty()) {
+      std::cerr << "No function '" << name << "'\n";
+      return nullptr;
+    }
+    return funcs[0]->lowlevel_func()->ifunc();
+  }
+
+  struct expect {
+    char const* func;
+    std::vector<Dyninst::MachRegister> written;
+    std::vector<Dyninst::MachRegister> untouched;
+    bool vector;
+  };
+}
+
+int main(int, char** argv) {
+  BPatch bpatch;
+  BPatch_binaryEdit* app = bpatch.openBinary(argv[0]);
+  if(!app) {
+    std::cerr << "Unable to open '" << argv[0] << "'\n";
+    return EXIT_FAILURE;
+  }
+  BPatch_image* image = app->getImage();
+  ABI* abi = ABI::getABI(8);
+
+  expect const cases[] = {
+    {"cwr_leaf", {x64::rax}, {x64::rcx, x64::rdx, x64::rbx}, false},
+    {"cwr_calls_leaf", {x64::rax, x64::rcx}, {x64::rdx, x64::rbx}, false},
+    // Callee-saved registers are restored before the call returns
+    {"cwr_saves_rbx", {}, {x64::rbx, x64::rax}, false},
+    {"cwr_recursive", {x64::rdx, x64::rdi}, {x64::rax, x64::rcx}, false},
+    {"cwr_vector", {}, {x64::rax, x64::rcx}, true},
+  };
+
+  bool ok = true;
+  for(auto const& c : cases) {
+    parse_func* f = find(image, c.func);
+    if(!f) return EXIT_FAILURE;
+    bitArray const& regs = f->callWrittenRegs();
+    for(auto r : c.written) {
+      if(!regs.test(abi->getIndex(r))) {
+        std::cerr << c.func << ": " << r.name() << " not in the summary\n";
+        ok = false;
+      }
+    }
+    for(auto r : c.untouched) {
+      if(regs.test(abi->getIndex(r))) {
+        std::cerr << c.func << ": " << r.name() << " in the summary\n";
+        ok = false;
+      }
+    }
+    if(f->callWritesVectorRegs() != c.vector) {
+      std::cerr << c.func << ": vector writes " << (c.vector ? "missed" : "reported") << '\n';
+      ok = false;
+    }
+  }
+
+  // A call through a pointer could reach anything the ABI allows
+  parse_func* f = find(image, "cwr_indirect");
+  if(!f) return EXIT_FAILURE;
+  if(f->callWrittenRegs() != abi->getCallWrittenRegisters() || !f->callWritesVectorRegs()) {
+    std::cerr << "cwr_indirect: summary is not the ABI's call-written set\n";
+    ok = false;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+// The RT library is C, and its headers do not say so
+extern "C" {
+#include "dyninstAPI_RT/h/dyninstAPI_RT.h"
+}
+
+/*
+ *  Checks that event rings are reused after their threads exit, so that
+ *  threads started later still queue their events.
+ */
+
+extern "C" {
+  extern int DYNINSTstaticMode;
+  extern int DYNINST_event_rings_enabled;
+  extern volatile unsigned DYNINST_event_rings_used;
+  extern DYNINSTeventRing_t DYNINST_event_rings[];
+  void DYNINSTBaseInit(void);
+}
+
+namespace {
+  // What the mutator does when the process stops
+  unsigned drain() {
+    unsigned records = 0;
+    for(unsigned i = 0; i < DYNINST_event_rings_used && i < DYNINST_EVENT_RINGS; ++i) {
+      DYNINSTeventRing_t& ring = DYNINST_event_rings[i];
+      records += ring.head - ring.tail;
+      ring.tail = ring.head;
+    }
+    return records;
+  }
+
+  // Runs nthreads threads, all alive at once, each queueing one message
+  bool run(int nthreads) {
+    pthread_barrier_t queued;
+    pthread_barrier_init(&queued, nullptr, static_cast<unsigned>(nthreads));
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nthreads; ++t)
+      threads.emplace_back([&queued, t] {
+        int msg = t;
+        DYNINSTuserMessage(&msg, sizeof(msg));
+        pthread_barrier_wait(&queued);
+      });
+    for(auto& t : threads)
+      t.join();
+    pthread_barrier_destroy(&queued);
+
+    unsigned const records = drain();
+    if(records != static_cast<unsigned>(nthreads)) {
+      std::fprintf(stderr, "%d threads queued %u events\n", nthreads, records);
+      return false;
+    }
+    return true;
+  }
+}
+
+int main() {
+  DYNINSTBaseInit();
+  DYNINSTstaticMode = 0;
+  DYNINST_event_rings_enabled = 1;
+
+  // Many more threads over the run than there are rings
+  for(int round = 0; round < 4 * DYNINST_EVENT_RINGS / 8; ++round) {
+    if(!run(8))
+      return EXIT_FAILURE;
+  }
+  if(DYNINST_event_rings_used > 8) {
+    std::fprintf(stderr, "%u rings used by 8 threads at a time\n", DYNINST_event_rings_used);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+// The RT library is C, and its headers do not say so
+extern "C" {
+#include "dyninstAPI_RT/h/dyninstAPI_RT.h"
+}
+
+/*
+ *  Checks that per-thread counter slabs are reused after their threads
+ *  exit and that no count is lost once every slab is taken.
+ */
+
+extern "C" {
+  extern DYNINSTcounterSlab_t DYNINST_counter_slabs[];
+  extern volatile unsigned DYNINST_counter_slabs_used;
+  extern DYNINSTcounterSlab_t DYNINST_counter_overflow;
+  extern long DYNINST_counter_tls_offset;
+  void DYNINST_thread_counter_add(long counter, long value);
+  void DYNINSTBaseInit(void);
+}
+
+namespace {
+  constexpr long counter = 3;
+  constexpr long calls = 1000;
+
+  // What BPatch_threadCounterExpr generates: add to the slab in TLS
+  // inline, and only call the RT library while there is none.
+  void count() {
+#if defined(__x86_64__)
+    if(DYNINST_counter_tls_offset) {
+      int64_t* slab;
+      __asm__ __volatile__("mov %%fs:(%1), %0" : "=r"(slab) : "r"(DYNINST_counter_tls_offset));
+      if(slab) {
+        slab[counter] += 1;
+        return;
+      }
+    }
+#endif
+    DYNINST_thread_counter_add(counter, 1);
+  }
+
+  long long sum() {
+    long long s = DYNINST_counter_overflow.counts[counter];
+    for(unsigned i = 0; i < DYNINST_counter_slabs_used && i < DYNINST_COUNTER_SLABS; ++i)
+      s += DYNINST_counter_slabs[i].counts[counter];
+    return s;
+  }
+
+  // Runs nthreads threads, all alive at once, counting calls times each
+  bool run(int nthreads) {
+    pthread_barrier_t started;
+    pthread_barrier_init(&started, nullptr, static_cast<unsigned>(nthreads));
+    long long const before = sum();
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nthreads; ++t)
+      threads.emplace_back([&started] {
+        count();
+        pthread_barrier_wait(&started);
+        for(long i = 1; i < calls; ++i)
+          count();
+      });
+    for(auto& t : threads)
+      t.join();
+    pthread_barrier_destroy(&started);
+
+    long long const counted = sum() - before;
+    if(counted != nthreads * calls) {
+      std::fprintf(stderr, "%d threads counted %lld of %ld\n", nthreads, counted, nthreads * calls);
+      return false;
+    }
+    return true;
+  }
+}
+
+int main() {
+  DYNINSTBaseInit();
+
+  // Many more threads over the run than there are slabs
+  for(int round = 0; round < 2 * DYNINST_COUNTER_SLABS / 16; ++round) {
+    if(!run(16))
+      return EXIT_FAILURE;
+  }
+  if(DYNINST_counter_slabs_used > 16) {
+    std::fprintf(stderr, "%u slabs used by 16 threads at a time\n", DYNINST_counter_slabs_used);
+    return EXIT_FAILURE;
+  }
+
+  // More threads at once than there are slabs
+  if(!run(DYNINST_COUNTER_SLABS + 64))
+    return EXIT_FAILURE;
+  if(DYNINST_counter_slabs_used != DYNINST_COUNTER_SLABS) {
+    std::fprintf(stderr, "%u slabs used, expected %d\n", DYNINST_counter_slabs_used,
+                 DYNINST_COUNTER_SLABS);
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
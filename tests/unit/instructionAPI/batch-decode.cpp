@@ -0,0 +1,124 @@
+#include "InstructionBatch.h"
+#include "InstructionDecoder.h"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace di = Dyninst::InstructionAPI;
+using ci = di::CompactInstruction;
+
+struct expected {
+  uint16_t flags;
+  int num_memory; // -1 to skip
+};
+
+std::array<const unsigned char, 32> x86_64_buffer = {{
+  0x48, 0x89, 0x18,              // mov [rax], rbx
+  0x48, 0x8b, 0x18,              // mov rbx, [rax]
+  0x48, 0x8d, 0x58, 0x08,        // lea rbx, [rax + 0x8]
+  0x48, 0x83, 0xc0, 0x01,        // add rax, 0x1
+  0x74, 0x02,                    // je +0x2
+  0xff, 0xd0,                    // call rax
+  0xe8, 0x00, 0x00, 0x00, 0x00,  // call +0x0
+  0xc3,                          // ret
+  0x90,                          // nop
+  0xf0, 0x90,                    // lock nop (lock is not allowed on nop)
+  0x90, 0x90, 0x90, 0x90, 0x90
+}};
+
+std::vector<expected> x86_64_answers = {
+  {ci::writes_memory, 1},
+  {ci::reads_memory, 1},
+  {0, 0},
+  {0, 0},
+  {ci::control_flow | ci::conditional, 0},
+  {ci::control_flow | ci::call | ci::indirect | ci::writes_memory, 0},
+  {ci::control_flow | ci::call | ci::writes_memory, 0},
+  {ci::control_flow | ci::ret | ci::reads_memory, 0},
+  {0, 0},
+};
+
+std::array<const uint32_t, 7> aarch64_buffer = {{
+  0x91000420,  // add x0, x1, #1
+  0xf9400020,  // ldr x0, [x1]
+  0xf9000020,  // str x0, [x1]
+  0x54000040,  // b.eq +8
+  0x94000001,  // bl +4
+  0xd63f0020,  // blr x1
+  0xd65f03c0,  // ret
+}};
+
+std::vector<expected> aarch64_answers = {
+  {0, 0},
+  {ci::reads_memory, 1},
+  {ci::writes_memory, 1},
+  {ci::control_flow | ci::conditional, 0},
+  {ci::control_flow | ci::call, 0},
+  {ci::control_flow | ci::call | ci::indirect, 0},
+  {ci::control_flow | ci::ret | ci::indirect, 0},
+};
+
+constexpr uint16_t checked_flags = ci::control_flow | ci::call | ci::ret | ci::conditional |
+                                   ci::indirect | ci::reads_memory | ci::writes_memory;
+
+bool run(const void* buf, size_t size, Dyninst::Architecture arch,
+         std::vector<expected> const& answers) {
+  di::InstructionDecoder dec(buf, size, arch);
+  di::InstructionBatch batch;
+  auto const n = dec.decodeBatch(batch);
+
+  if(n != answers.size()) {
+    std::cerr << "Expected " << answers.size() << " instructions, decoded " << n << "\n";
+    return false;
+  }
+
+  // The batch must agree with one-at-a-time decoding
+  di::InstructionDecoder single(buf, size, arch);
+  for(size_t i = 0; i < n; i++) {
+    auto const& rec = batch[i];
+    auto const insn = single.decode();
+    if(rec.id != insn.getOperation().getID() || rec.length != insn.size() ||
+       rec.getCategory() != insn.getCategory()) {
+      std::cerr << "Record " << i << " disagrees with '" << insn.format() << "'\n";
+      return false;
+    }
+    if(batch.ptr(rec) != insn.ptr() || !(batch.instruction(i) == insn)) {
+      std::cerr << "Record " << i << " does not materialize '" << insn.format() << "'\n";
+      return false;
+    }
+    if((rec.flags & checked_flags) != answers[i].flags) {
+      std::cerr << "Wrong flags for '" << insn.format() << "': " << rec.flags << "\n";
+      return false;
+    }
+    if(answers[i].num_memory != -1 && rec.num_memory != answers[i].num_memory) {
+      std::cerr << "Wrong memory operand count for '" << insn.format() << "'\n";
+      return false;
+    }
+  }
+
+  // The decoder stops on the first illegal instruction
+  if(batch.bytes() != size && dec.decode().isLegalInsn()) {
+    std::cerr << "Batch stopped on a legal instruction\n";
+    return false;
+  }
+  return true;
+}
+
+int main() {
+  // Convention for CTest
+  constexpr int PASS = 0;
+  constexpr int FAIL = 1;
+
+  std::cout << "Running x86_64\n";
+  if(!run(x86_64_buffer.data(), x86_64_buffer.size(), Dyninst::Arch_x86_64, x86_64_answers))
+    return FAIL;
+
+  std::cout << "Running aarch64\n";
+  if(!run(aarch64_buffer.data(), aarch64_buffer.size() * sizeof(uint32_t),
+          Dyninst::Arch_aarch64, aarch64_answers))
+    return FAIL;
+
+  return PASS;
+}
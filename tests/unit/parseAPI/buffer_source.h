@@ -0,0 +1,49 @@
+#ifndef DYNINST_UNIT_TESTS_PARSEAPI_BUFFER_SOURCE_H
+#define DYNINST_UNIT_TESTS_PARSEAPI_BUFFER_SOURCE_H
+
+#include "CodeSource.h"
+
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace dp = Dyninst::ParseAPI;
+using Dyninst::Address;
+
+namespace {
+  // A CodeSource over in-memory regions
+  class buffer_source : public dp::CodeSource {
+  public:
+    explicit buffer_source(std::vector<dp::CodeRegion*> const& regs) {
+      for(auto* r : regs) addRegion(r);
+    }
+
+    bool isValidAddress(const Address a) const override { return lookup(a) != nullptr; }
+    void* getPtrToInstruction(const Address a) const override {
+      auto* r = lookup(a);
+      return r ? r->getPtrToInstruction(a) : nullptr;
+    }
+    void* getPtrToData(const Address) const override { return nullptr; }
+    unsigned int getAddressWidth() const override { return 8; }
+    bool isCode(const Address a) const override { return lookup(a) != nullptr; }
+    bool isData(const Address) const override { return false; }
+    bool isReadOnly(const Address) const override { return false; }
+    Address offset() const override { return 0; }
+    Address length() const override { return 0; }
+    Dyninst::Architecture getArch() const override { return Dyninst::Arch_x86_64; }
+
+  private:
+    dp::CodeRegion* lookup(Address a) const {
+      std::set<dp::CodeRegion*> regs;
+      findRegions(a, regs);
+      return regs.empty() ? nullptr : *regs.begin();
+    }
+  };
+
+  bool fail(char const* msg) {
+    std::cerr << msg << '\n';
+    return false;
+  }
+}
+
+#endif
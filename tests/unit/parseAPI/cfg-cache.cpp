@@ -0,0 +1,120 @@
+#include "CodeObject.h"
+#include "CodeSource.h"
+#include "Function.h"
+#include "Symbol.h"
+#include "Symtab.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <utility>
+
+namespace dp = Dyninst::ParseAPI;
+namespace st = Dyninst::SymtabAPI;
+
+extern "C" __attribute__((noinline, used)) int cfg_cache_hint_a(int x) { return x + 1; }
+extern "C" __attribute__((noinline, used)) int cfg_cache_hint_b(int x) { return x * 2; }
+
+namespace {
+  struct counts {
+    size_t funcs{}, blocks{}, edges{};
+  };
+
+  counts count(dp::CodeObject& co) {
+    counts c;
+    for(auto* f : co.funcs()) {
+      c.funcs++;
+      for(auto* b : f->blocks()) {
+        c.blocks++;
+        c.edges += b->targets().size();
+      }
+    }
+    return c;
+  }
+
+  // Drops one function's hint, leaving the same number of hints either way
+  struct drop_hint : dp::SymtabCodeSource::hint_filt {
+    std::string name;
+    explicit drop_hint(std::string n) : name(std::move(n)) {}
+    bool operator()(st::Function* f) override {
+      return f->getFirstSymbol() && f->getFirstSymbol()->getMangledName() == name;
+    }
+  };
+
+  // A cache written under one set of hints must not load under another
+  bool options_in_key(char const* exe) {
+    std::string const cache = "cfg-cache-options." + std::to_string(getpid()) + ".cfg";
+    st::Symtab* obj{};
+    if(!st::Symtab::openFile(obj, exe)) return false;
+
+    drop_hint drop_a("cfg_cache_hint_a"), drop_b("cfg_cache_hint_b");
+    auto* src_a = new dp::SymtabCodeSource(obj, &drop_a);
+    auto* co_a = new dp::CodeObject(src_a);
+    bool const saved = co_a->saveCFGCache(cache);
+
+    auto* src_b = new dp::SymtabCodeSource(obj, &drop_b);
+    auto* co_b = new dp::CodeObject(src_b, nullptr, nullptr, false, true);
+    bool const loaded = co_b->loadCFGCache(cache);
+    std::remove(cache.c_str());
+
+    delete co_b;
+    delete src_b;
+    delete co_a;
+    delete src_a;
+    if(!saved || loaded) {
+      std::cerr << (saved ? "Loaded a CFG cache written with other hints\n"
+                          : "Unable to write CFG cache '" + cache + "'\n");
+      return false;
+    }
+    return true;
+  }
+}
+
+int main(int, char** argv) {
+  std::string const cache = "cfg-cache-test." + std::to_string(getpid()) + ".cfg";
+
+  auto* parsed_src = new dp::SymtabCodeSource(argv[0]);
+  auto* parsed = new dp::CodeObject(parsed_src);
+  auto const expected = count(*parsed);
+
+  if(!parsed->saveCFGCache(cache)) {
+    std::cerr << "Unable to write CFG cache '" << cache << "'\n";
+    return EXIT_FAILURE;
+  }
+
+  // Load into a fresh, unparsed CodeObject over the same binary
+  auto* cached_src = new dp::SymtabCodeSource(argv[0]);
+  auto* cached = new dp::CodeObject(cached_src, nullptr, nullptr, false, true);
+  bool const loaded = cached->loadCFGCache(cache);
+
+  // A cache can only be applied before parsing
+  bool const reloaded = parsed->loadCFGCache(cache);
+  std::remove(cache.c_str());
+
+  if(!loaded) {
+    std::cerr << "Unable to load CFG cache\n";
+    return EXIT_FAILURE;
+  }
+
+  auto const actual = count(*cached);
+  if(actual.funcs != expected.funcs || actual.blocks != expected.blocks ||
+     actual.edges != expected.edges) {
+    std::cerr << "Mismatch: parsed " << expected.funcs << '/' << expected.blocks << '/'
+              << expected.edges << ", cached " << actual.funcs << '/' << actual.blocks
+              << '/' << actual.edges << '\n';
+    return EXIT_FAILURE;
+  }
+
+  if(reloaded) {
+    std::cerr << "Loaded a CFG cache into a parsed CodeObject\n";
+    return EXIT_FAILURE;
+  }
+
+  delete cached;
+  delete cached_src;
+  delete parsed;
+  delete parsed_src;
+  return options_in_key(argv[0]) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
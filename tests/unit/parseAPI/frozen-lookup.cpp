@@ -0,0 +1,90 @@
+#include "CodeObject.h"
+#include "CFGModifier.h"
+#include "buffer_source.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+  // clang-format off
+  unsigned char code[0x100] = {
+    0xe8, 0x0b, 0x00, 0x00, 0x00,   // 0x1000: call 0x1010
+    0xc3,                           // 0x1005: ret
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc,
+    0x31, 0xc0,                     // 0x1010: xor eax, eax
+    0xc3,                           // 0x1012: ret
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc,
+    0xb8, 0x01, 0x00, 0x00, 0x00,   // 0x1020: mov eax, 1
+    0xc3,                           // 0x1025: ret
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc
+    // 0x1030 on: filled with ret below
+  };
+  // clang-format on
+
+  // Every lookup at every address around the region, as text
+  std::string lookups(dp::CodeObject& co, dp::CodeRegion* reg) {
+    std::ostringstream out;
+    for(Address a = 0xff8; a < 0x1038; ++a) {
+      std::set<dp::Function*> funcs, range_funcs;
+      std::set<dp::Block*> blocks;
+      co.findFuncs(reg, a, funcs);
+      co.findFuncs(reg, a, a + 8, range_funcs);
+      co.findBlocks(reg, a, blocks);
+      out << std::hex << a << ':' << co.findFuncByEntry(reg, a) << ','
+          << co.findBlockByEntry(reg, a);
+      for(auto* f : funcs) out << " f" << f->addr();
+      for(auto* f : range_funcs) out << " r" << f->addr();
+      for(auto* b : blocks) out << " b" << b->start() << '-' << b->end();
+      out << '\n';
+    }
+    return out.str();
+  }
+
+  bool run() {
+    std::fill(code + 0x30, code + sizeof code, 0xc3);
+    auto* reg = new dp::InsertedRegion(0x1000, code, sizeof code, Dyninst::Arch_x86_64);
+    buffer_source src({reg});
+    dp::CodeObject co(&src, nullptr, nullptr, false, true);
+    co.parse({{0x1000, reg}}, true);
+
+    // Lookups before and after freezing agree
+    std::string const live = lookups(co, reg);
+    co.finalize();
+    if(lookups(co, reg) != live) return fail("Lookups differ after finalize()");
+    co.freezeLookups();
+    if(lookups(co, reg) != live) return fail("Frozen lookups differ from the live tables");
+    if(!co.findFuncByEntry(reg, 0x1010)) return fail("Callee not found");
+
+    // Parsing more code thaws the tables
+    co.parse({{0x1020, reg}}, true);
+    auto* late = co.findFuncByEntry(reg, 0x1020);
+    if(!late) return fail("Function parsed after finalize() not found");
+
+    std::string const reparsed = lookups(co, reg);
+    co.freezeLookups();
+    if(lookups(co, reg) != reparsed) return fail("Lookups differ after refreezing");
+
+    // Each new function drops the previous tables, which are freed as no
+    // lookup is running
+    for(Address a = 0x1040; a < 0x1040 + 100; ++a) {
+      co.parse({{a, reg}}, true);
+      if(!co.findFuncByEntry(reg, a)) return fail("Function parsed after refreezing not found");
+      co.freezeLookups();
+    }
+    if(lookups(co, reg) != reparsed) return fail("Lookups differ after repeated refreezing");
+
+    std::set<dp::Block*> blocks;
+    if(co.findBlocks(reg, 0x1023, blocks) != 1 || *blocks.begin() != late->entry())
+      return fail("Block of the late function not found by address");
+    return true;
+  }
+}
+
+int main() {
+  return run() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+#include "CodeObject.h"
+#include "CFGModifier.h"
+#include "buffer_source.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+namespace {
+  // clang-format off
+  unsigned char caller[] = {
+    0xe8, 0xfb, 0x0f, 0x00, 0x00,   // 0x1000: call 0x2000
+    0xe8, 0x06, 0x10, 0x00, 0x00,   // 0x1005: call 0x2010
+    0xc3                            // 0x100a: ret
+  };
+
+  unsigned char plugin_v1[0x20] = {
+    0xb8, 0x01, 0x00, 0x00, 0x00,   // 0x2000: mov eax, 1
+    0xc3,                           // 0x2005: ret
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc,
+    0x31, 0xc0,                     // 0x2010: xor eax, eax
+    0xc3,                           // 0x2012: ret
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc
+  };
+
+  unsigned char plugin_v2[0x20] = {
+    0xb8, 0x01, 0x00, 0x00, 0x00,   // 0x2000: mov eax, 1
+    0xc3,                           // 0x2005: ret
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc,
+    0xb8, 0x02, 0x00, 0x00, 0x00,   // 0x2010: mov eax, 2
+    0xc3,                           // 0x2015: ret
+    0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc
+  };
+  // clang-format on
+
+  bool run() {
+    auto const arch = Dyninst::Arch_x86_64;
+    auto* main_reg = new dp::InsertedRegion(0x1000, caller, sizeof caller, arch);
+    auto* old_reg = new dp::InsertedRegion(0x2000, plugin_v1, sizeof plugin_v1, arch);
+
+    buffer_source src({main_reg, old_reg});
+    dp::CodeObject co(&src, nullptr, nullptr, false, true);
+    co.parse({{0x1000, main_reg}}, true);
+
+    auto* main_func = co.findFuncByEntry(main_reg, 0x1000);
+    auto* same_func = co.findFuncByEntry(old_reg, 0x2000);
+    if(!main_func || !same_func || !co.findFuncByEntry(old_reg, 0x2010))
+      return fail("Initial parse did not find all functions");
+
+    auto* new_reg = new dp::InsertedRegion(0x2000, plugin_v2, sizeof plugin_v2, arch);
+    if(!co.replaceRegion(old_reg, new_reg)) return fail("replaceRegion failed");
+
+    // Unchanged code keeps its objects
+    if(co.findFuncByEntry(main_reg, 0x1000) != main_func)
+      return fail("Caller in another region was rebuilt");
+    if(co.findFuncByEntry(new_reg, 0x2000) != same_func || same_func->region() != new_reg)
+      return fail("Unchanged function in the replaced region was rebuilt");
+
+    // Changed code is re-parsed
+    auto* changed = co.findFuncByEntry(new_reg, 0x2010);
+    if(!changed || changed->entry()->end() != 0x2016)
+      return fail("Changed function was not re-parsed");
+
+    if(co.funcs().size() != 3) return fail("Wrong number of functions after replacement");
+
+    // Calls into the replaced region are relinked to the new code
+    std::set<Address> callees;
+    for(auto* b : main_func->blocks()) {
+      for(auto* e : b->targets()) {
+        if(e->type() != dp::CALL) continue;
+        if(e->sinkEdge()) return fail("Call edge left unresolved");
+        callees.insert(e->trg()->start());
+        if(e->trg()->start() == 0x2010 && e->trg() != changed->entry())
+          return fail("Call edge not relinked to the re-parsed function");
+      }
+    }
+    if(callees != std::set<Address>{0x2000, 0x2010}) return fail("Call edges were lost");
+
+    return true;
+  }
+}
+
+int main() {
+  return run() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
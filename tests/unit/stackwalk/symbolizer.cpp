@@ -0,0 +1,108 @@
+#include "Symtab.h"
+#include "Symbol.h"
+#include "frame.h"
+#include "procstate.h"
+#include "symlookup.h"
+#include "walker.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace st = Dyninst::SymtabAPI;
+namespace sw = Dyninst::Stackwalker;
+
+namespace symbolizer_test {
+  __attribute__((noinline, used)) int target(int x) { return x * 3 + 1; }
+
+  // Names every address, so frames must be named through it
+  struct custom_lookup : sw::SymbolLookup {
+    bool lookupAtAddr(Dyninst::Address, std::string& out_name, void*& out_value) override {
+      out_name = "custom_lookup_name";
+      out_value = nullptr;
+      return true;
+    }
+  };
+
+  bool frames_use_lookup() {
+    sw::ProcSelf* self = new sw::ProcSelf();
+    self->initialize();
+    sw::Walker* walker = sw::Walker::newWalker(self, nullptr, new custom_lookup());
+    std::vector<sw::Frame> frames;
+    if(!walker || !walker->walkStack(frames) || frames.empty()) {
+      std::cerr << "Unable to walk the current stack\n";
+      return false;
+    }
+    std::vector<sw::SymbolInfo> out;
+    sw::Symbolizer symbolizer;
+    symbolizer.lookup(frames, out);
+    for(size_t i = 0; i < out.size(); ++i) {
+      if(!out[i].found || out[i].name != "custom_lookup_name") {
+        std::cerr << "Frame " << i << " named '" << out[i].name << "' without the walker's lookup\n";
+        return false;
+      }
+    }
+    return out.size() == frames.size();
+  }
+}
+
+int main(int, char** argv) {
+  st::Symtab* obj{};
+  if(!st::Symtab::openFile(obj, argv[0])) {
+    std::cerr << "Unable to open '" << argv[0] << "'\n";
+    return EXIT_FAILURE;
+  }
+  std::vector<st::Symbol*> syms;
+  if(!obj->findSymbol(syms, "symbolizer_test::target", st::Symbol::ST_FUNCTION, st::prettyName) ||
+     syms.empty()) {
+    std::cerr << "No symbol for symbolizer_test::target\n";
+    return EXIT_FAILURE;
+  }
+  Dyninst::Offset const off = syms[0]->getOffset() + 1;
+
+  // A second name for the same file must share its reader
+  std::string const alias = "symbolizer-alias-" + std::to_string(getpid());
+  if(symlink(argv[0], alias.c_str()) != 0) {
+    std::cerr << "Unable to create '" << alias << "'\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<sw::Symbolizer::LibOffset> addrs = {
+      {argv[0], off}, {argv[0], off}, {alias, off}, {argv[0], 0}};
+  std::vector<sw::SymbolInfo> out;
+  bool all_found;
+  {
+    sw::Symbolizer symbolizer;
+    all_found = symbolizer.lookup(addrs, out);
+  }
+  unlink(alias.c_str());
+
+  bool ok = true;
+  if(all_found || out.size() != addrs.size()) {
+    std::cerr << "Expected " << addrs.size() << " results with one miss\n";
+    ok = false;
+  }
+  for(size_t i = 0; ok && i < 3; ++i) {
+    if(!out[i].found || out[i].name.find("symbolizer_test::target") == std::string::npos) {
+      std::cerr << "Address " << i << " resolved to '" << out[i].name << "'\n";
+      ok = false;
+    }
+  }
+  if(ok && out[3].found) {
+    std::cerr << "Offset 0 resolved to '" << out[3].name << "'\n";
+    ok = false;
+  }
+  if(ok && (out[0].file != out[2].file || out[0].line != out[2].line)) {
+    std::cerr << "Line information differs between names for the same file\n";
+    ok = false;
+  }
+
+  if(ok && !symbolizer_test::frames_use_lookup())
+    ok = false;
+
+  st::Symtab::closeSymtab(obj);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,151 @@
+#include "Symtab.h"
+#include "Function.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace st = Dyninst::SymtabAPI;
+
+namespace lazy_symbols_test {
+  __attribute__((noinline, used)) int probe(int x) { return x + 1; }
+
+  struct widget {
+    int v;
+    widget operator+(int x) const;
+  };
+  widget widget::operator+(int x) const { return widget{v + x}; }
+}
+
+// Its members' mangled names spell std::allocator as a substitution
+template class std::allocator<lazy_symbols_test::widget>;
+
+namespace {
+  struct snapshot {
+    size_t symbols{};
+    size_t functions{};
+    size_t by_pretty{};
+    Dyninst::Offset main_offset{};
+  };
+
+  // Pretty names whose identifiers are not spelled out in the mangled names
+  char const* const pretty_names[] = {
+    "std::allocator<lazy_symbols_test::widget>::allocator",
+    "lazy_symbols_test::widget::operator+",
+  };
+
+  bool take(st::Symtab* obj, snapshot& s) {
+    std::vector<st::Symbol*> mains;
+    if(!obj->findSymbol(mains, "main", st::Symbol::ST_FUNCTION, st::mangledName)) {
+      std::cerr << "No symbol for 'main'\n";
+      return false;
+    }
+    s.main_offset = mains.front()->getOffset();
+
+    std::vector<st::Function*> probes;
+    if(!obj->findFunctionsByName(probes, "lazy_symbols_test::probe", st::prettyName)) {
+      std::cerr << "No function for 'lazy_symbols_test::probe'\n";
+      return false;
+    }
+
+    for(auto n : pretty_names) {
+      std::vector<st::Symbol*> found;
+      if(!obj->findSymbol(found, n, st::Symbol::ST_FUNCTION, st::prettyName)) {
+        std::cerr << "No symbol for '" << n << "'\n";
+        return false;
+      }
+      s.by_pretty += found.size();
+    }
+
+    std::vector<st::Symbol*> syms;
+    obj->getAllSymbols(syms);
+    s.symbols = syms.size();
+
+    std::vector<st::Function*> funcs;
+    obj->getAllFunctions(funcs);
+    s.functions = funcs.size();
+    return true;
+  }
+
+  bool same(snapshot const& eager, snapshot const& lazy, char const* what) {
+    if(lazy.symbols == eager.symbols && lazy.functions == eager.functions &&
+       lazy.by_pretty == eager.by_pretty && lazy.main_offset == eager.main_offset)
+      return true;
+    std::cerr << what << " mismatch: eager " << eager.symbols << '/' << eager.functions << '/'
+              << eager.by_pretty << ", lazy " << lazy.symbols << '/' << lazy.functions << '/'
+              << lazy.by_pretty << '\n';
+    return false;
+  }
+
+  bool take_file(std::string const& path, st::Symtab::symload_t load, snapshot& s) {
+    st::Symtab* obj{};
+    if(!st::Symtab::openFile(obj, path, st::Symtab::NotDefensive, load)) {
+      std::cerr << "Unable to open '" << path << "'\n";
+      return false;
+    }
+    bool const ok = take(obj, s);
+    st::Symtab::closeSymtab(obj);
+    return ok;
+  }
+
+  // Writes the index for a copy of 'exe', then reads it back
+  bool persistent(std::string const& exe, snapshot const& eager) {
+    char dir[] = "/tmp/lazy_symbols.XXXXXX";
+    if(!mkdtemp(dir)) {
+      std::cerr << "Unable to create a temporary directory\n";
+      return false;
+    }
+    std::string const copy = std::string(dir) + "/exe";
+    std::string const index = copy + ".symidx";
+    {
+      std::ifstream in(exe, std::ios::binary);
+      std::ofstream out(copy, std::ios::binary);
+      out << in.rdbuf();
+    }
+
+    bool ok = true;
+    snapshot written, loaded;
+    if(!take_file(copy, st::Symtab::PersistentLazySymbols, written) || !same(eager, written, "Writing")) {
+      ok = false;
+    } else if(access(index.c_str(), R_OK) != 0) {
+      std::cerr << "No symbol index written to '" << index << "'\n";
+      ok = false;
+    } else if(!take_file(copy, st::Symtab::PersistentLazySymbols, loaded) || !same(eager, loaded, "Loading")) {
+      ok = false;
+    }
+
+    std::remove(index.c_str());
+    std::remove(copy.c_str());
+    rmdir(dir);
+    return ok;
+  }
+}
+
+int main(int, char** argv) {
+  snapshot eager;
+  if(!take_file(argv[0], st::Symtab::EagerSymbols, eager)) return EXIT_FAILURE;
+
+  st::Symtab* obj{};
+  if(!st::Symtab::openFile(obj, argv[0], st::Symtab::NotDefensive, st::Symtab::LazySymbols)) {
+    std::cerr << "Unable to lazily open '" << argv[0] << "'\n";
+    return EXIT_FAILURE;
+  }
+
+  // Offset lookups must materialize symbols before any name lookup has
+  if(obj->findSymbolByOffset(eager.main_offset).empty()) {
+    std::cerr << "No lazy symbol at main's offset\n";
+    return EXIT_FAILURE;
+  }
+
+  snapshot lazy;
+  if(!take(obj, lazy)) return EXIT_FAILURE;
+  st::Symtab::closeSymtab(obj);
+
+  if(!same(eager, lazy, "Lazy")) return EXIT_FAILURE;
+  return persistent(argv[0], eager) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,72 @@
+#include "Symtab.h"
+#include "Symbol.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace st = Dyninst::SymtabAPI;
+
+namespace symbol_search_test {
+  __attribute__((noinline, used)) int alpha_one(int x) { return x + 1; }
+  __attribute__((noinline, used)) int alpha_two(int x) { return x + 2; }
+  __attribute__((noinline, used)) int beta(int x) { return x + 3; }
+}
+
+namespace {
+  using query = st::Symtab::SymbolQuery;
+
+  bool expect(std::vector<st::Symbol*> const& found, size_t n, char const* what) {
+    if(found.size() != n) {
+      std::cerr << what << ": expected " << n << " symbols, found " << found.size() << '\n';
+      return false;
+    }
+    return true;
+  }
+}
+
+int main(int, char** argv) {
+  st::Symtab* obj{};
+  if(!st::Symtab::openFile(obj, argv[0])) {
+    std::cerr << "Unable to open '" << argv[0] << "'\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<query> queries = {
+      query("symbol_search_test::alpha_*", query::Wildcard, st::Symbol::ST_FUNCTION, st::prettyName, true),
+      query("SYMBOL_SEARCH_TEST::BETA", query::Wildcard, st::Symbol::ST_FUNCTION, st::prettyName, false),
+      query("^symbol_search_test::alpha_(one|two)$", query::Regex, st::Symbol::ST_FUNCTION, st::prettyName, true),
+      query("search_test::[a-z]+_t.o\\(int\\)$", query::Regex, st::Symbol::ST_FUNCTION, st::typedName, true),
+      query("main", query::Exact, st::Symbol::ST_FUNCTION, st::mangledName, true),
+      query("symbol_search_test::gamma*", query::Wildcard, st::Symbol::ST_UNKNOWN, st::anyName, true),
+  };
+  std::vector<std::vector<st::Symbol*>> found;
+  bool ok = obj->findSymbols(found, queries);
+  ok = ok && found.size() == queries.size();
+  ok = ok && expect(found[0], 2, "wildcard prefix");
+  ok = ok && expect(found[1], 1, "case-insensitive wildcard");
+  ok = ok && expect(found[2], 2, "regex alternation");
+  ok = ok && expect(found[3], 1, "regex on typed names");
+  ok = ok && expect(found[4], 1, "exact");
+  ok = ok && expect(found[5], 0, "no match");
+
+  // An invalid expression fails the batch but not the other queries
+  queries.push_back(query("alpha_(", query::Regex));
+  if(obj->findSymbols(found, queries) || found[0].size() != 2 || !found.back().empty()) {
+    std::cerr << "Invalid regex was not reported\n";
+    ok = false;
+  }
+
+  // findSymbol's wildcard search agrees with a scan of every symbol
+  std::vector<st::Symbol*> all, by_scan, by_index;
+  obj->getAllDefinedSymbols(all);
+  for(auto* s : all) {
+    if(s->getPrettyName().find("_search_test::") != std::string::npos) by_scan.push_back(s);
+  }
+  obj->findSymbol(by_index, "*_search_test::*", st::Symbol::ST_UNKNOWN, st::prettyName, true, true);
+  ok = ok && expect(by_index, by_scan.size(), "findSymbol wildcard");
+
+  st::Symtab::closeSymtab(obj);
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}